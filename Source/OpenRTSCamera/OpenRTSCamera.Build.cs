@@ -39,6 +39,12 @@ public class OpenRTSCamera : ModuleRules
 			}
 		);
 
+		if (Target.bBuildEditor)
+		{
+			// Heightfields are baked into assets of their own
+			PrivateDependencyModuleNames.Add("AssetRegistry");
+		}
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
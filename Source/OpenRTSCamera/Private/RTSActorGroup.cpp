@@ -0,0 +1,270 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSActorGroup.h"
+
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+void URTSActorGroup::AddActor(AActor* Actor)
+{
+	const auto Root = Actor != nullptr ? Actor->GetRootComponent() : nullptr;
+	if (Root == nullptr || this->ActorToMember.Contains(Actor))
+	{
+		return;
+	}
+
+	const auto Location = Root->GetComponentLocation();
+	const auto Index = this->Members.Add(Actor);
+	this->MemberRoots.Add(Root);
+	this->MemberLocations.Add(Location);
+	this->MemberTransformHandles.Add(
+		Root->TransformUpdated.AddUObject(this, &URTSActorGroup::OnMemberTransformUpdated)
+	);
+	this->ActorToMember.Add(Actor, Index);
+	this->RootToMember.Add(Root, Index);
+	Actor->OnEndPlay.AddDynamic(this, &URTSActorGroup::OnMemberEndPlay);
+
+	this->LocationSum += Location;
+	this->AddToExtremumHeaps(Index);
+}
+
+void URTSActorGroup::RemoveActor(AActor* Actor)
+{
+	const auto FoundIndex = this->ActorToMember.Find(Actor);
+	if (FoundIndex == nullptr)
+	{
+		return;
+	}
+
+	const auto Index = *FoundIndex;
+	this->LocationSum -= this->MemberLocations[Index];
+	this->RemoveFromExtremumHeaps(Index);
+
+	this->UnbindMember(Index);
+	this->ActorToMember.Remove(Actor);
+	this->RootToMember.Remove(this->MemberRoots[Index]);
+
+	this->Members.RemoveAtSwap(Index, 1, false);
+	this->MemberRoots.RemoveAtSwap(Index, 1, false);
+	this->MemberLocations.RemoveAtSwap(Index, 1, false);
+	this->MemberTransformHandles.RemoveAtSwap(Index, 1, false);
+
+	// Patch the indices of the member that was swapped into the hole
+	if (Index < this->Members.Num())
+	{
+		this->ActorToMember[this->Members[Index]] = Index;
+		this->RootToMember[this->MemberRoots[Index]] = Index;
+	}
+
+	if (this->Members.Num() == 0)
+	{
+		this->LocationSum = FVector::ZeroVector;
+	}
+}
+
+void URTSActorGroup::SetActors(const TArray<AActor*>& Actors)
+{
+	this->Reset();
+	for (const auto Actor : Actors)
+	{
+		this->AddActor(Actor);
+	}
+}
+
+void URTSActorGroup::Reset()
+{
+	for (int32 Index = 0; Index < this->Members.Num(); ++Index)
+	{
+		this->UnbindMember(Index);
+	}
+
+	this->Members.Reset();
+	this->MemberRoots.Reset();
+	this->MemberLocations.Reset();
+	this->MemberTransformHandles.Reset();
+	this->ActorToMember.Reset();
+	this->RootToMember.Reset();
+	this->LocationSum = FVector::ZeroVector;
+	for (auto& Heap : this->ExtremumHeaps)
+	{
+		Heap.Heap.Reset();
+		Heap.Positions.Reset();
+	}
+}
+
+bool URTSActorGroup::Contains(const AActor* Actor) const
+{
+	return this->ActorToMember.Contains(Actor);
+}
+
+int32 URTSActorGroup::Num() const
+{
+	return this->Members.Num();
+}
+
+TArray<AActor*> URTSActorGroup::GetActors() const
+{
+	return this->Members;
+}
+
+FVector URTSActorGroup::GetCentroid() const
+{
+	return this->Members.Num() > 0 ? this->LocationSum / this->Members.Num() : FVector::ZeroVector;
+}
+
+FBox URTSActorGroup::GetBounds() const
+{
+	if (this->Members.Num() == 0)
+	{
+		return FBox(ForceInit);
+	}
+
+	FVector Maximum;
+	FVector Minimum;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Maximum[Axis] = this->MemberLocations[this->ExtremumHeaps[Axis].Heap[0]][Axis];
+		Minimum[Axis] = this->MemberLocations[this->ExtremumHeaps[Axis + 3].Heap[0]][Axis];
+	}
+
+	return FBox(Minimum, Maximum);
+}
+
+void URTSActorGroup::OnMemberTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags, ETeleportType)
+{
+	const auto FoundIndex = this->RootToMember.Find(UpdatedComponent);
+	if (FoundIndex == nullptr)
+	{
+		return;
+	}
+
+	const auto Index = *FoundIndex;
+	const auto OldLocation = this->MemberLocations[Index];
+	const auto NewLocation = UpdatedComponent->GetComponentLocation();
+	this->MemberLocations[Index] = NewLocation;
+	this->LocationSum += NewLocation - OldLocation;
+	this->UpdateInExtremumHeaps(Index);
+}
+
+void URTSActorGroup::OnMemberEndPlay(AActor* Actor, EEndPlayReason::Type)
+{
+	this->RemoveActor(Actor);
+}
+
+void URTSActorGroup::UnbindMember(const int32 Index)
+{
+	if (IsValid(this->MemberRoots[Index]))
+	{
+		this->MemberRoots[Index]->TransformUpdated.Remove(this->MemberTransformHandles[Index]);
+	}
+
+	if (IsValid(this->Members[Index]))
+	{
+		this->Members[Index]->OnEndPlay.RemoveDynamic(this, &URTSActorGroup::OnMemberEndPlay);
+	}
+}
+
+void URTSActorGroup::AddToExtremumHeaps(const int32 Index)
+{
+	for (auto& Heap : this->ExtremumHeaps)
+	{
+		Heap.Positions.Add(Heap.Heap.Add(Index));
+		this->SiftUp(Heap, Heap.Heap.Num() - 1);
+	}
+}
+
+void URTSActorGroup::UpdateInExtremumHeaps(const int32 Index)
+{
+	// Members that keep their order relative to their neighbours, e.g. a group marching in formation, stop sifting
+	// after a single comparison
+	for (auto& Heap : this->ExtremumHeaps)
+	{
+		const auto Position = Heap.Positions[Index];
+		this->SiftUp(Heap, Position);
+		this->SiftDown(Heap, Heap.Positions[Index]);
+	}
+}
+
+void URTSActorGroup::RemoveFromExtremumHeaps(const int32 Index)
+{
+	const auto LastIndex = this->Members.Num() - 1;
+	for (auto& Heap : this->ExtremumHeaps)
+	{
+		// Take the member out of the heap by moving the last heap entry into its place
+		const auto Position = Heap.Positions[Index];
+		const auto LastPosition = Heap.Heap.Num() - 1;
+		if (Position != LastPosition)
+		{
+			this->SwapHeapEntries(Heap, Position, LastPosition);
+		}
+		Heap.Heap.Pop(false);
+		if (Position < Heap.Heap.Num())
+		{
+			const auto Replacement = Heap.Heap[Position];
+			this->SiftUp(Heap, Position);
+			this->SiftDown(Heap, Heap.Positions[Replacement]);
+		}
+
+		// The last member takes over the removed member's index
+		if (Index != LastIndex)
+		{
+			const auto MovedPosition = Heap.Positions[LastIndex];
+			Heap.Heap[MovedPosition] = Index;
+			Heap.Positions[Index] = MovedPosition;
+		}
+		Heap.Positions.Pop(false);
+	}
+}
+
+double URTSActorGroup::GetHeapKey(const FExtremumHeap& Heap, const int32 Position) const
+{
+	return Heap.Sign * this->MemberLocations[Heap.Heap[Position]][Heap.Axis];
+}
+
+void URTSActorGroup::SwapHeapEntries(FExtremumHeap& Heap, const int32 A, const int32 B)
+{
+	Heap.Heap.Swap(A, B);
+	Heap.Positions[Heap.Heap[A]] = A;
+	Heap.Positions[Heap.Heap[B]] = B;
+}
+
+void URTSActorGroup::SiftUp(FExtremumHeap& Heap, int32 Position)
+{
+	while (Position > 0)
+	{
+		const auto Parent = (Position - 1) / 2;
+		if (this->GetHeapKey(Heap, Position) <= this->GetHeapKey(Heap, Parent))
+		{
+			return;
+		}
+
+		this->SwapHeapEntries(Heap, Position, Parent);
+		Position = Parent;
+	}
+}
+
+void URTSActorGroup::SiftDown(FExtremumHeap& Heap, int32 Position)
+{
+	const auto Num = Heap.Heap.Num();
+	while (true)
+	{
+		const auto Left = Position * 2 + 1;
+		const auto Right = Left + 1;
+		auto Largest = Position;
+		if (Left < Num && this->GetHeapKey(Heap, Left) > this->GetHeapKey(Heap, Largest))
+		{
+			Largest = Left;
+		}
+		if (Right < Num && this->GetHeapKey(Heap, Right) > this->GetHeapKey(Heap, Largest))
+		{
+			Largest = Right;
+		}
+		if (Largest == Position)
+		{
+			return;
+		}
+
+		this->SwapHeapEntries(Heap, Position, Largest);
+		Position = Largest;
+	}
+}
@@ -2,19 +2,29 @@
 
 #include "RTSCamera.h"
 
-#include "Blueprint/WidgetLayoutLibrary.h"
+#include "RTSActorGroup.h"
+#include "RTSCameraBoundsSubsystem.h"
+#include "RTSCameraStats.h"
+#include "RTSCameraSubsystem.h"
+#include "RTSViewportSubsystem.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
 #include "Runtime/CoreUObject/Public/UObject/ConstructorHelpers.h"
 
 URTSCamera::URTSCamera()
 {
+	// Updated by URTSCameraSubsystem together with every other camera. The component tick stays available, but off,
+	// so that Blueprint subclasses can still use Event Tick.
 	PrimaryComponentTick.bCanEverTick = true;
-	this->CameraBlockingVolumeTag = FName("OpenRTSCamera#CameraBounds");
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	this->IsAwake = true;
+	this->BoundsSubsystem = nullptr;
+	this->CameraFollowGroup = nullptr;
+	this->FollowTargetsGroup = nullptr;
+	this->ViewportSubsystem = nullptr;
 	this->CollisionChannel = ECC_WorldStatic;
 	this->DragExtent = 0.6f;
 	this->EdgeScrollSpeed = 50;
@@ -22,11 +32,16 @@ URTSCamera::URTSCamera()
 	this->EnableCameraLag = true;
 	this->EnableCameraRotationLag = true;
 	this->EnableDynamicCameraHeight = true;
+	this->EnableAsyncGroundTrace = false;
 	this->EnableEdgeScrolling = true;
+	this->EnableGroupFraming = true;
 	this->FindGroundTraceLength = 100000;
+	this->GroupFramingPadding = 1.25f;
 	this->MaximumZoomLength = 5000;
 	this->MinimumZoomLength = 500;
 	this->MoveSpeed = 50;
+	this->PendingMovement = FVector2D::ZeroVector;
+	this->PendingYawDelta = 0;
 	this->RotateSpeed = 45;
 	this->StartingYAngle = -45.0f;
 	this->StartingZAngle = 0;
@@ -69,93 +84,91 @@ void URTSCamera::BeginPlay()
 	{
 		this->CollectComponentDependencyReferences();
 		this->ConfigureSpringArm();
-		this->TryToFindBoundaryVolumeReference();
+		this->BindToBoundsSubsystem();
 		this->ConditionallyEnableEdgeScrolling();
 		this->CheckForEnhancedInputComponent();
 		this->BindInputMappingContext();
 		this->BindInputActions();
+
+		if (const auto Subsystem = this->GetWorld()->GetSubsystem<URTSCameraSubsystem>())
+		{
+			Subsystem->RegisterCamera(this);
+		}
+	}
+
+	// The camera itself has nothing to do on tick, only run it for Blueprint subclasses that implement Event Tick
+	if (this->GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(URTSCamera, ReceiveTick)))
+	{
+		this->SetComponentTickEnabled(true);
 	}
 }
 
-void URTSCamera::TickComponent(
-	const float DeltaTime,
-	const ELevelTick TickType,
-	FActorComponentTickFunction* ThisTickFunction
-)
+void URTSCamera::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	const auto NetMode = this->GetNetMode();
-	if (NetMode != NM_DedicatedServer && this->PlayerController->GetViewTarget() == this->Owner)
+	if (this->BoundsSubsystem != nullptr)
 	{
-		this->DeltaSeconds = DeltaTime;
-		this->ApplyMoveCameraCommands();
-		this->ConditionallyPerformEdgeScrolling();
-		this->ConditionallyKeepCameraAtDesiredZoomAboveGround();
-		this->SmoothTargetArmLengthToDesiredZoom();
-		this->FollowTargetIfSet();
-		this->ConditionallyApplyCameraBounds();
+		this->BoundsSubsystem->OnCameraBoundsChanged.RemoveAll(this);
+		this->BoundsSubsystem->OnHeightfieldInvalidated.RemoveAll(this);
+		this->BoundsSubsystem = nullptr;
 	}
+
+	if (const auto Subsystem = this->GetWorld()->GetSubsystem<URTSCameraSubsystem>())
+	{
+		Subsystem->UnregisterCamera(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void URTSCamera::FollowTarget(AActor* Target)
 {
 	this->CameraFollowTarget = Target;
+	this->CameraFollowGroup = nullptr;
+	this->WakeUp();
+}
+
+void URTSCamera::FollowTargets(const TArray<AActor*>& Targets)
+{
+	if (this->FollowTargetsGroup == nullptr)
+	{
+		this->FollowTargetsGroup = NewObject<URTSActorGroup>(this);
+	}
+
+	this->FollowTargetsGroup->SetActors(Targets);
+	this->FollowGroup(this->FollowTargetsGroup);
+}
+
+void URTSCamera::FollowGroup(URTSActorGroup* Group)
+{
+	this->CameraFollowTarget = nullptr;
+	this->CameraFollowGroup = Group;
+	this->WakeUp();
 }
 
 void URTSCamera::UnFollowTarget()
 {
 	this->CameraFollowTarget = nullptr;
+	this->CameraFollowGroup = nullptr;
 }
 
 void URTSCamera::OnZoomCamera(const FInputActionValue& Value)
 {
-	this->DesiredZoomLength = FMath::Clamp(
-		this->DesiredZoomLength + Value.Get<float>() * this->ZoomSpeed,
-		this->MinimumZoomLength,
-		this->MaximumZoomLength
-	);
+	this->SetZoomLength(this->DesiredZoomLength + Value.Get<float>() * this->ZoomSpeed);
 }
 
 void URTSCamera::OnRotateCamera(const FInputActionValue& Value)
 {
-	const auto WorldRotation = this->Root->GetComponentRotation();
-	this->Root->SetWorldRotation(
-		FRotator::MakeFromEuler(
-			FVector(
-				WorldRotation.Euler().X,
-				WorldRotation.Euler().Y,
-				WorldRotation.Euler().Z + Value.Get<float>()
-			)
-		)
-	);
+	this->RequestRotateCamera(Value.Get<float>());
 }
 
 void URTSCamera::OnTurnCameraLeft(const FInputActionValue&)
 {
-	const auto WorldRotation = this->Root->GetRelativeRotation();
-	this->Root->SetRelativeRotation(
-		FRotator::MakeFromEuler(
-			FVector(
-				WorldRotation.Euler().X,
-				WorldRotation.Euler().Y,
-				WorldRotation.Euler().Z - this->RotateSpeed
-			)
-		)
-	);
+	this->RequestRotateCamera(-this->RotateSpeed);
 }
 
 void URTSCamera::OnTurnCameraRight(const FInputActionValue&)
 {
-	const auto WorldRotation = this->Root->GetRelativeRotation();
-	this->Root->SetRelativeRotation(
-		FRotator::MakeFromEuler(
-			FVector(
-				WorldRotation.Euler().X,
-				WorldRotation.Euler().Y,
-				WorldRotation.Euler().Z + this->RotateSpeed
-			)
-		)
-	);
+	this->RequestRotateCamera(this->RotateSpeed);
 }
 
 void URTSCamera::OnMoveCameraYAxis(const FInputActionValue& Value)
@@ -181,16 +194,16 @@ void URTSCamera::OnDragCamera(const FInputActionValue& Value)
 	if (!this->IsDragging && Value.Get<bool>())
 	{
 		this->IsDragging = true;
-		this->DragStartLocation = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
+		this->DragStartLocation = this->ViewportSubsystem->GetViewportSnapshot().CursorPosition;
+		this->WakeUp();
 	}
 
 	else if (this->IsDragging && Value.Get<bool>())
 	{
-		const auto MousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-		auto DragExtents = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-		DragExtents *= DragExtent;
+		const auto& Snapshot = this->ViewportSubsystem->GetViewportSnapshot();
+		const auto DragExtents = Snapshot.ViewportSize * DragExtent;
 
-		auto Delta = MousePosition - this->DragStartLocation;
+		auto Delta = Snapshot.CursorPosition - this->DragStartLocation;
 		Delta.X = FMath::Clamp(Delta.X, -DragExtents.X, DragExtents.X) / DragExtents.X;
 		Delta.Y = FMath::Clamp(Delta.Y, -DragExtents.Y, DragExtents.Y) / DragExtents.Y;
 
@@ -215,26 +228,152 @@ void URTSCamera::OnDragCamera(const FInputActionValue& Value)
 
 void URTSCamera::RequestMoveCamera(const float X, const float Y, const float Scale)
 {
-	FMoveCameraCommand MoveCameraCommand;
-	MoveCameraCommand.X = X;
-	MoveCameraCommand.Y = Y;
-	MoveCameraCommand.Scale = Scale;
-	MoveCameraCommands.Push(MoveCameraCommand);
+	auto Direction = FVector2D(X, Y);
+	Direction.Normalize();
+	this->PendingMovement += Direction * Scale;
+	INC_DWORD_STAT(STAT_RTSCameraMoveCommands);
+	this->WakeUp();
+}
+
+void URTSCamera::RequestRotateCamera(const float YawDelta)
+{
+	this->PendingYawDelta += YawDelta;
+	this->WakeUp();
+}
+
+void URTSCamera::ApplyMoveCameraCommands(FRTSCameraState& State) const
+{
+	const auto Movement = State.Movement * this->MoveSpeed * State.DeltaSeconds;
+	State.Location += FVector(Movement.X, Movement.Y, 0.0f);
+}
+
+void URTSCamera::ApplyRotateCameraCommands(FRTSCameraState& State) const
+{
+	State.Rotation.Yaw += State.YawDelta;
+}
+
+bool URTSCamera::GatherCameraState(FRTSCameraState& State, const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraGather);
+
+	// Sleeping cameras only look at the cursor, which the viewport snapshot has already captured for this frame
+	if ((!this->IsAwake && !this->IsCursorInEdgeBand()) || this->PlayerController->GetViewTarget() != this->Owner)
+	{
+		return false;
+	}
+	this->IsAwake = true;
+
+	State.Location = this->Root->GetComponentLocation();
+	State.Rotation = this->Root->GetComponentRotation();
+	State.ArmLength = this->SpringArm->TargetArmLength;
+	State.DeltaSeconds = DeltaTime;
+
+	State.Movement = this->PendingMovement;
+	State.YawDelta = this->PendingYawDelta;
+	this->PendingMovement = FVector2D::ZeroVector;
+	this->PendingYawDelta = 0;
+
+	State.IsEdgeScrolling = this->EnableEdgeScrolling && !this->IsDragging;
+	if (State.IsEdgeScrolling)
+	{
+		const auto& Snapshot = this->ViewportSubsystem->GetViewportSnapshot();
+		State.MousePosition = Snapshot.CursorPosition;
+		State.ViewportSize = Snapshot.ViewportSize;
+	}
+
+	State.IsFollowingTarget = this->CameraFollowTarget != nullptr;
+	if (State.IsFollowingTarget)
+	{
+		State.FollowTargetLocation = this->CameraFollowTarget->GetActorLocation();
+	}
+
+	// The group keeps its centroid and bounds up to date as members move, so this does not visit every member
+	else if (this->CameraFollowGroup != nullptr && this->CameraFollowGroup->Num() > 0)
+	{
+		State.IsFollowingTarget = true;
+		State.FollowTargetLocation = this->CameraFollowGroup->GetCentroid();
+		if (this->EnableGroupFraming)
+		{
+			this->DesiredZoomLength = this->GetGroupFramingZoomLength(this->CameraFollowGroup->GetBounds());
+		}
+	}
+
+	return true;
 }
 
-void URTSCamera::ApplyMoveCameraCommands()
+void URTSCamera::UpdateCameraMovement(FRTSCameraState& State) const
 {
-	for (const auto& [X, Y, Scale] : this->MoveCameraCommands)
 	{
-		auto Movement = FVector2D(X, Y);
-		Movement.Normalize();
-		Movement *= this->MoveSpeed * Scale * this->DeltaSeconds;
-		this->Root->SetWorldLocation(
-			this->Root->GetComponentLocation() + FVector(Movement.X, Movement.Y, 0.0f)
-		);
+		SCOPE_CYCLE_COUNTER(STAT_RTSCameraApplyCommands);
+		this->ApplyRotateCameraCommands(State);
+		this->ApplyMoveCameraCommands(State);
 	}
 
-	this->MoveCameraCommands.Empty();
+	this->ConditionallyPerformEdgeScrolling(State);
+}
+
+void URTSCamera::UpdateCameraFraming(FRTSCameraState& State) const
+{
+	this->SmoothTargetArmLengthToDesiredZoom(State);
+	this->FollowTargetIfSet(State);
+	this->ConditionallyApplyCameraBounds(State);
+}
+
+bool URTSCamera::CommitCameraState(const FRTSCameraState& State) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraCommit);
+
+	auto DidCameraChange = false;
+
+	// Skipping unchanged transforms also skips propagating them to the spring arm and camera
+	if (!State.Location.Equals(this->Root->GetComponentLocation(), 0.0)
+		|| !State.Rotation.Equals(this->Root->GetComponentRotation(), 0.0))
+	{
+		this->Root->SetWorldLocationAndRotation(State.Location, State.Rotation);
+		DidCameraChange = true;
+	}
+
+	if (State.ArmLength != this->SpringArm->TargetArmLength)
+	{
+		this->SpringArm->TargetArmLength = State.ArmLength;
+		DidCameraChange = true;
+	}
+
+	return DidCameraChange;
+}
+
+bool URTSCamera::HasPendingWork() const
+{
+	return this->IsDragging
+		|| this->IsCursorInEdgeBand()
+		|| this->CameraFollowTarget != nullptr
+		|| this->CameraFollowGroup != nullptr
+		|| !this->PendingMovement.IsZero()
+		|| this->PendingYawDelta != 0
+		|| this->SpringArm->TargetArmLength != this->DesiredZoomLength;
+}
+
+bool URTSCamera::IsCursorInEdgeBand() const
+{
+	if (!this->EnableEdgeScrolling || this->IsDragging || this->ViewportSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const auto& Snapshot = this->ViewportSubsystem->GetViewportSnapshot();
+	return Snapshot.ViewportSize.X > 0.0
+		&& Snapshot.ViewportSize.Y > 0.0
+		&& !this->GetEdgeScroll(Snapshot.CursorPosition, Snapshot.ViewportSize).IsZero();
+}
+
+void URTSCamera::ConditionallyFallAsleep(const bool DidCameraChange)
+{
+	// A camera that still changed this tick stays awake for one more, which also lets the result of a ground trace
+	// issued during that tick land before going to sleep
+	if (!DidCameraChange && !this->HasPendingWork())
+	{
+		this->IsAwake = false;
+	}
 }
 
 void URTSCamera::CollectComponentDependencyReferences()
@@ -244,6 +383,7 @@ void URTSCamera::CollectComponentDependencyReferences()
 	this->Camera = Cast<UCameraComponent>(this->Owner->GetComponentByClass(UCameraComponent::StaticClass()));
 	this->SpringArm = Cast<USpringArmComponent>(this->Owner->GetComponentByClass(USpringArmComponent::StaticClass()));
 	this->PlayerController = UGameplayStatics::GetPlayerController(this->GetWorld(), 0);
+	this->ViewportSubsystem = this->GetWorld()->GetSubsystem<URTSViewportSubsystem>();
 }
 
 void URTSCamera::ConfigureSpringArm()
@@ -264,22 +404,25 @@ void URTSCamera::ConfigureSpringArm()
 	);
 }
 
-void URTSCamera::TryToFindBoundaryVolumeReference()
+void URTSCamera::BindToBoundsSubsystem()
 {
-	TArray<AActor*> BlockingVolumes;
-	UGameplayStatics::GetAllActorsOfClassWithTag(
-		this->GetWorld(),
-		AActor::StaticClass(),
-		this->CameraBlockingVolumeTag,
-		BlockingVolumes
-	);
-
-	if (BlockingVolumes.Num() > 0)
+	this->BoundsSubsystem = this->GetWorld()->GetSubsystem<URTSCameraBoundsSubsystem>();
+	if (this->BoundsSubsystem != nullptr)
 	{
-		this->BoundaryVolume = BlockingVolumes[0];
+		this->BoundsSubsystem->OnCameraBoundsChanged.AddUObject(this, &URTSCamera::OnCameraBoundsChanged);
+		this->BoundsSubsystem->OnHeightfieldInvalidated.AddUObject(this, &URTSCamera::WakeUp);
+		this->OnCameraBoundsChanged();
 	}
 }
 
+void URTSCamera::OnCameraBoundsChanged()
+{
+	this->CameraBounds = this->BoundsSubsystem->GetCameraBounds();
+
+	// A sleeping camera may now be out of bounds
+	this->WakeUp();
+}
+
 void URTSCamera::ConditionallyEnableEdgeScrolling() const
 {
 	if (this->EnableEdgeScrolling)
@@ -390,189 +533,250 @@ void URTSCamera::BindInputActions()
 	}
 }
 
-void URTSCamera::SetActiveCamera() const
+void URTSCamera::SetActiveCamera()
 {
 	this->PlayerController->SetViewTarget(this->GetOwner());
+	this->WakeUp();
 }
 
-void URTSCamera::JumpTo(const FVector Position) const
+void URTSCamera::JumpTo(const FVector Position)
 {
 	this->Root->SetWorldLocation(Position);
+	this->WakeUp();
 }
 
-void URTSCamera::ConditionallyPerformEdgeScrolling() const
+void URTSCamera::SetZoomLength(const float ZoomLength)
 {
-	if (this->EnableEdgeScrolling && !this->IsDragging)
-	{
-		this->EdgeScrollLeft();
-		this->EdgeScrollRight();
-		this->EdgeScrollUp();
-		this->EdgeScrollDown();
-	}
+	this->DesiredZoomLength = FMath::Clamp(ZoomLength, this->MinimumZoomLength, this->MaximumZoomLength);
+	this->WakeUp();
 }
 
-void URTSCamera::EdgeScrollLeft() const
+void URTSCamera::RotateCamera(const float YawDelta)
 {
-	const auto MousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto ViewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto NormalizedMousePosition = 1 - UKismetMathLibrary::NormalizeToRange(
-		MousePosition.X,
-		0.0f,
-		ViewportSize.X * this->DistanceFromEdgeThreshold
-	);
-
-	const auto Movement = UKismetMathLibrary::FClamp(NormalizedMousePosition, 0.0, 1.0);
+	this->RequestRotateCamera(YawDelta);
+}
 
-	this->Root->AddRelativeLocation(
-		-1 * this->Root->GetRightVector() * Movement * this->EdgeScrollSpeed * this->DeltaSeconds
-	);
+void URTSCamera::WakeUp()
+{
+	this->IsAwake = true;
 }
 
-void URTSCamera::EdgeScrollRight() const
+void URTSCamera::ConditionallyPerformEdgeScrolling(FRTSCameraState& State) const
 {
-	const auto MousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto ViewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto NormalizedMousePosition = UKismetMathLibrary::NormalizeToRange(
-		MousePosition.X,
-		ViewportSize.X * (1 - this->DistanceFromEdgeThreshold),
-		ViewportSize.X
-	);
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraEdgeScroll);
 
-	const auto Movement = UKismetMathLibrary::FClamp(NormalizedMousePosition, 0.0, 1.0);
-	this->Root->AddRelativeLocation(
-		this->Root->GetRightVector() * Movement * this->EdgeScrollSpeed * this->DeltaSeconds
-	);
+	if (!State.IsEdgeScrolling || State.ViewportSize.X <= 0.0 || State.ViewportSize.Y <= 0.0)
+	{
+		return;
+	}
+
+	const auto Scroll = this->GetEdgeScroll(State.MousePosition, State.ViewportSize);
+
+	// Screen Y points down, so scrolling down moves the camera backwards
+	const auto Rotation = State.Rotation.Quaternion();
+	State.Location += (Rotation.GetRightVector() * Scroll.X - Rotation.GetForwardVector() * Scroll.Y)
+		* this->EdgeScrollSpeed * State.DeltaSeconds;
 }
 
-void URTSCamera::EdgeScrollUp() const
+FVector2D URTSCamera::GetEdgeScroll(const FVector2D& MousePosition, const FVector2D& ViewportSize) const
 {
-	const auto MousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto ViewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto NormalizedMousePosition = UKismetMathLibrary::NormalizeToRange(
-		MousePosition.Y,
-		0.0f,
-		ViewportSize.Y * this->DistanceFromEdgeThreshold
-	);
-
-	const auto Movement = 1 - UKismetMathLibrary::FClamp(NormalizedMousePosition, 0.0, 1.0);
-	this->Root->AddRelativeLocation(
-		this->Root->GetForwardVector() * Movement * this->EdgeScrollSpeed * this->DeltaSeconds
-	);
+	// How far the cursor is into the left/top (Near) and right/bottom (Far) edge bands, from 0 to 1 per axis
+	const auto EdgeSize = FVector2D::Max(ViewportSize * this->DistanceFromEdgeThreshold, FVector2D(1.0, 1.0));
+	const auto Near = (FVector2D::UnitVector - MousePosition / EdgeSize).ClampAxes(0.0, 1.0);
+	const auto Far = ((MousePosition - ViewportSize + EdgeSize) / EdgeSize).ClampAxes(0.0, 1.0);
+	return Far - Near;
 }
 
-void URTSCamera::EdgeScrollDown() const
+void URTSCamera::FollowTargetIfSet(FRTSCameraState& State) const
 {
-	const auto MousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(this->GetWorld());
-	const auto ViewportSize = UWidgetLayoutLibrary::GetViewportWidgetGeometry(this->GetWorld()).GetLocalSize();
-	const auto NormalizedMousePosition = UKismetMathLibrary::NormalizeToRange(
-		MousePosition.Y,
-		ViewportSize.Y * (1 - this->DistanceFromEdgeThreshold),
-		ViewportSize.Y
-	);
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraFollow);
 
-	const auto Movement = UKismetMathLibrary::FClamp(NormalizedMousePosition, 0.0, 1.0);
-	this->Root->AddRelativeLocation(
-		-1 * this->Root->GetForwardVector() * Movement * this->EdgeScrollSpeed * this->DeltaSeconds
-	);
+	if (State.IsFollowingTarget)
+	{
+		State.Location = State.FollowTargetLocation;
+	}
 }
 
-void URTSCamera::FollowTargetIfSet() const
+float URTSCamera::GetGroupFramingZoomLength(const FBox& GroupBounds) const
 {
-	if (this->CameraFollowTarget != nullptr)
+	const auto Extent = GroupBounds.GetExtent();
+	const auto Radius = FVector2D(Extent.X, Extent.Y).Size() * this->GroupFramingPadding;
+
+	// Fit the bounding circle into the narrower of the horizontal and vertical field of view
+	auto HalfFieldOfView = FMath::DegreesToRadians(this->Camera != nullptr ? this->Camera->FieldOfView : 90.0f) * 0.5f;
+	const auto& ViewportSize = this->ViewportSubsystem->GetViewportSnapshot().ViewportSize;
+	if (ViewportSize.X > ViewportSize.Y && ViewportSize.Y > 0.0)
 	{
-		this->Root->SetWorldLocation(this->CameraFollowTarget->GetActorLocation());
+		HalfFieldOfView = FMath::Atan(FMath::Tan(HalfFieldOfView) * ViewportSize.Y / ViewportSize.X);
 	}
+
+	return FMath::Clamp(
+		static_cast<float>(Radius / FMath::Tan(HalfFieldOfView)),
+		this->MinimumZoomLength,
+		this->MaximumZoomLength
+	);
 }
 
-void URTSCamera::SmoothTargetArmLengthToDesiredZoom() const
+void URTSCamera::SmoothTargetArmLengthToDesiredZoom(FRTSCameraState& State) const
 {
-	this->SpringArm->TargetArmLength = FMath::FInterpTo(
-		this->SpringArm->TargetArmLength,
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraZoom);
+
+	State.ArmLength = FMath::FInterpTo(
+		State.ArmLength,
 		this->DesiredZoomLength,
-		this->DeltaSeconds,
+		State.DeltaSeconds,
 		this->ZoomCatchupSpeed
 	);
 }
 
-void URTSCamera::ConditionallyKeepCameraAtDesiredZoomAboveGround()
+void URTSCamera::ConditionallyKeepCameraAtDesiredZoomAboveGround(FRTSCameraState& State)
 {
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraGroundHeight);
+
 	if (this->EnableDynamicCameraHeight)
 	{
-		const auto RootWorldLocation = this->Root->GetComponentLocation();
-		const TArray<AActor*> ActorsToIgnore;
+		// A baked heightfield on the bounds volume makes the ground trace unnecessary
+		float GroundHeight;
+		if (this->BoundsSubsystem != nullptr && this->BoundsSubsystem->SampleHeightfield(State.Location, GroundHeight))
+		{
+			State.Location.Z = GroundHeight;
+		}
 
-		auto HitResult = FHitResult();
-		auto DidHit = UKismetSystemLibrary::LineTraceSingle(
-			this->GetWorld(),
-			FVector(RootWorldLocation.X, RootWorldLocation.Y, RootWorldLocation.Z + this->FindGroundTraceLength),
-			FVector(RootWorldLocation.X, RootWorldLocation.Y, RootWorldLocation.Z - this->FindGroundTraceLength),
-			UEngineTypes::ConvertToTraceType(this->CollisionChannel),
-			true,
-			ActorsToIgnore,
-			EDrawDebugTrace::Type::None,
-			HitResult,
-			true
+		else if (this->EnableAsyncGroundTrace)
+		{
+			this->KeepCameraAboveGroundAsync(State);
+		}
+
+		else
+		{
+			this->KeepCameraAboveGround(State);
+		}
+	}
+}
+
+void URTSCamera::KeepCameraAboveGround(FRTSCameraState& State)
+{
+	const auto RootWorldLocation = State.Location;
+	const TArray<AActor*> ActorsToIgnore;
+
+	auto HitResult = FHitResult();
+	INC_DWORD_STAT(STAT_RTSCameraGroundTraces);
+	CSV_CUSTOM_STAT(OpenRTSCamera, GroundTraces, 1, ECsvCustomStatOp::Accumulate);
+	auto DidHit = UKismetSystemLibrary::LineTraceSingle(
+		this->GetWorld(),
+		FVector(RootWorldLocation.X, RootWorldLocation.Y, RootWorldLocation.Z + this->FindGroundTraceLength),
+		FVector(RootWorldLocation.X, RootWorldLocation.Y, RootWorldLocation.Z - this->FindGroundTraceLength),
+		UEngineTypes::ConvertToTraceType(this->CollisionChannel),
+		true,
+		ActorsToIgnore,
+		EDrawDebugTrace::Type::None,
+		HitResult,
+		true
+	);
+
+	if (DidHit)
+	{
+		State.Location = FVector(
+			HitResult.Location.X,
+			HitResult.Location.Y,
+			HitResult.Location.Z
 		);
+	}
+
+	else
+	{
+		this->ReportCameraNotOnGround();
+	}
+}
 
-		if (DidHit)
+void URTSCamera::KeepCameraAboveGroundAsync(FRTSCameraState& State)
+{
+	const auto World = this->GetWorld();
+
+	// Results of last frame's trace are available for exactly one frame, only their height is applied since the
+	// camera may have moved horizontally in the meantime
+	FTraceDatum TraceDatum;
+	if (World->QueryTraceData(this->GroundTraceHandle, TraceDatum))
+	{
+		if (TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit)
 		{
-			this->Root->SetWorldLocation(
-				FVector(
-					HitResult.Location.X,
-					HitResult.Location.Y,
-					HitResult.Location.Z
-				)
-			);
+			State.Location.Z = TraceDatum.OutHits[0].Location.Z;
 		}
 
-		else if (!this->IsCameraOutOfBoundsErrorAlreadyDisplayed)
+		else
 		{
-			this->IsCameraOutOfBoundsErrorAlreadyDisplayed = true;
-
-			UKismetSystemLibrary::PrintString(
-				this->GetWorld(),
-				"Or add a `RTSCameraBoundsVolume` actor to the scene.",
-				true,
-				true,
-				FLinearColor::Red,
-				100
-			);
-
-			UKismetSystemLibrary::PrintString(
-				this->GetWorld(),
-				"Increase trace length or change the starting position of the parent actor for the spring arm.",
-				true,
-				true,
-				FLinearColor::Red,
-				100
-			);
-
-			UKismetSystemLibrary::PrintString(
-				this->GetWorld(),
-				"Error: AC_RTSCamera needs to be placed on the ground!",
-				true,
-				true,
-				FLinearColor::Red,
-				100
-			);
+			this->ReportCameraNotOnGround();
 		}
 	}
+
+	FVector TraceStart;
+	FVector TraceEnd;
+	this->GetGroundTraceEndpoints(State.Location, TraceStart, TraceEnd);
+	INC_DWORD_STAT(STAT_RTSCameraGroundTraces);
+	CSV_CUSTOM_STAT(OpenRTSCamera, GroundTraces, 1, ECsvCustomStatOp::Accumulate);
+	this->GroundTraceHandle = World->AsyncLineTraceByChannel(
+		EAsyncTraceType::Single,
+		TraceStart,
+		TraceEnd,
+		this->CollisionChannel,
+		FCollisionQueryParams(SCENE_QUERY_STAT(RTSCameraGroundTrace), true, this->Owner)
+	);
 }
 
-void URTSCamera::ConditionallyApplyCameraBounds() const
+void URTSCamera::GetGroundTraceEndpoints(const FVector& Location, FVector& OutStart, FVector& OutEnd) const
 {
-	if (this->BoundaryVolume != nullptr)
+	OutStart = FVector(Location.X, Location.Y, Location.Z + this->FindGroundTraceLength);
+	OutEnd = FVector(Location.X, Location.Y, Location.Z - this->FindGroundTraceLength);
+
+	// With a bounds volume the ground is known to be within its height, so the async trace only covers that range
+	if (!this->CameraBounds.IsEmpty())
 	{
-		const auto RootWorldLocation = this->Root->GetComponentLocation();
-		FVector Origin;
-		FVector Extents;
-		this->BoundaryVolume->GetActorBounds(false, Origin, Extents);
-		this->Root->SetWorldLocation(
-			FVector(
-				UKismetMathLibrary::Clamp(RootWorldLocation.X, Origin.X - Extents.X, Origin.X + Extents.X),
-				UKismetMathLibrary::Clamp(RootWorldLocation.Y, Origin.Y - Extents.Y, Origin.Y + Extents.Y),
-				RootWorldLocation.Z
-			)
+		OutStart.Z = this->CameraBounds.MaximumZ;
+		OutEnd.Z = this->CameraBounds.MinimumZ;
+	}
+}
+
+void URTSCamera::ReportCameraNotOnGround()
+{
+	if (!this->IsCameraOutOfBoundsErrorAlreadyDisplayed)
+	{
+		this->IsCameraOutOfBoundsErrorAlreadyDisplayed = true;
+
+		UKismetSystemLibrary::PrintString(
+			this->GetWorld(),
+			"Or add a `RTSCameraBoundsVolume` actor to the scene.",
+			true,
+			true,
+			FLinearColor::Red,
+			100
+		);
+
+		UKismetSystemLibrary::PrintString(
+			this->GetWorld(),
+			"Increase trace length or change the starting position of the parent actor for the spring arm.",
+			true,
+			true,
+			FLinearColor::Red,
+			100
+		);
+
+		UKismetSystemLibrary::PrintString(
+			this->GetWorld(),
+			"Error: AC_RTSCamera needs to be placed on the ground!",
+			true,
+			true,
+			FLinearColor::Red,
+			100
 		);
 	}
 }
+
+void URTSCamera::ConditionallyApplyCameraBounds(FRTSCameraState& State) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraBounds);
+
+	if (!this->CameraBounds.IsEmpty())
+	{
+		State.Location = this->CameraBounds.Clamp(State.Location);
+	}
+}
@@ -0,0 +1,183 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraBounds.h"
+
+FRTSCameraBoundsPolygon FRTSCameraBoundsPolygon::MakeConvexHull(TArray<FVector2D> Points)
+{
+	FRTSCameraBoundsPolygon Polygon;
+	if (Points.Num() < 3)
+	{
+		return Polygon;
+	}
+
+	Points.Sort([](const FVector2D& A, const FVector2D& B)
+	{
+		return A.X < B.X || (A.X == B.X && A.Y < B.Y);
+	});
+
+	// Andrew's monotone chain, producing the hull in counter-clockwise order
+	const auto Cross = [](const FVector2D& O, const FVector2D& A, const FVector2D& B)
+	{
+		return FVector2D::CrossProduct(A - O, B - O);
+	};
+
+	auto& Hull = Polygon.Vertices;
+	Hull.Reserve(Points.Num() + 1);
+	for (const auto& Point : Points)
+	{
+		while (Hull.Num() >= 2 && Cross(Hull[Hull.Num() - 2], Hull.Last(), Point) <= 0.0)
+		{
+			Hull.Pop(false);
+		}
+		Hull.Add(Point);
+	}
+
+	const auto LowerHullSize = Hull.Num() + 1;
+	for (auto Index = Points.Num() - 2; Index >= 0; --Index)
+	{
+		while (Hull.Num() >= LowerHullSize && Cross(Hull[Hull.Num() - 2], Hull.Last(), Points[Index]) <= 0.0)
+		{
+			Hull.Pop(false);
+		}
+		Hull.Add(Points[Index]);
+	}
+
+	// The last point closes the loop
+	Hull.Pop(false);
+
+	if (Hull.Num() < 3)
+	{
+		return FRTSCameraBoundsPolygon();
+	}
+
+	Polygon.BuildHalfPlanes();
+	return Polygon;
+}
+
+FRTSCameraBoundsPolygon FRTSCameraBoundsPolygon::MakeBox(const FBox2D& Box)
+{
+	FRTSCameraBoundsPolygon Polygon;
+	Polygon.Vertices = {
+		Box.Min,
+		FVector2D(Box.Max.X, Box.Min.Y),
+		Box.Max,
+		FVector2D(Box.Min.X, Box.Max.Y),
+	};
+	Polygon.BuildHalfPlanes();
+	return Polygon;
+}
+
+bool FRTSCameraBoundsPolygon::IsValid() const
+{
+	return this->Vertices.Num() >= 3;
+}
+
+bool FRTSCameraBoundsPolygon::Contains(const FVector2D& Point) const
+{
+	for (int32 Index = 0; Index < this->Normals.Num(); ++Index)
+	{
+		if ((this->Normals[Index] | Point) > this->Distances[Index])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FVector2D FRTSCameraBoundsPolygon::GetClosestPoint(const FVector2D& Point) const
+{
+	if (this->Contains(Point))
+	{
+		return Point;
+	}
+
+	auto ClosestPoint = Point;
+	auto ClosestDistanceSquared = TNumericLimits<double>::Max();
+	for (int32 Index = 0; Index < this->Vertices.Num(); ++Index)
+	{
+		const auto& Start = this->Vertices[Index];
+		const auto& End = this->Vertices[(Index + 1) % this->Vertices.Num()];
+		const auto Candidate = FMath::ClosestPointOnSegment2D(Point, Start, End);
+		const auto DistanceSquared = FVector2D::DistSquared(Point, Candidate);
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestPoint = Candidate;
+		}
+	}
+
+	return ClosestPoint;
+}
+
+void FRTSCameraBoundsPolygon::BuildHalfPlanes()
+{
+	const auto NumVertices = this->Vertices.Num();
+	this->Normals.SetNumUninitialized(NumVertices);
+	this->Distances.SetNumUninitialized(NumVertices);
+	for (int32 Index = 0; Index < NumVertices; ++Index)
+	{
+		const auto& Start = this->Vertices[Index];
+		const auto Edge = this->Vertices[(Index + 1) % NumVertices] - Start;
+
+		// Vertices are counter-clockwise, so the outward normal is the edge rotated clockwise
+		this->Normals[Index] = FVector2D(Edge.Y, -Edge.X).GetSafeNormal();
+		this->Distances[Index] = this->Normals[Index] | Start;
+	}
+}
+
+void FRTSCameraBounds::Reset()
+{
+	this->Polygons.Reset();
+	this->MinimumZ = TNumericLimits<double>::Max();
+	this->MaximumZ = TNumericLimits<double>::Lowest();
+}
+
+void FRTSCameraBounds::AddPolygon(FRTSCameraBoundsPolygon&& Polygon, const double InMinimumZ, const double InMaximumZ)
+{
+	if (Polygon.IsValid())
+	{
+		this->Polygons.Add(MoveTemp(Polygon));
+		this->MinimumZ = FMath::Min(this->MinimumZ, InMinimumZ);
+		this->MaximumZ = FMath::Max(this->MaximumZ, InMaximumZ);
+	}
+}
+
+void FRTSCameraBounds::Append(const FRTSCameraBounds& Other)
+{
+	if (!Other.IsEmpty())
+	{
+		this->Polygons.Append(Other.Polygons);
+		this->MinimumZ = FMath::Min(this->MinimumZ, Other.MinimumZ);
+		this->MaximumZ = FMath::Max(this->MaximumZ, Other.MaximumZ);
+	}
+}
+
+bool FRTSCameraBounds::IsEmpty() const
+{
+	return this->Polygons.Num() == 0;
+}
+
+FVector FRTSCameraBounds::Clamp(const FVector& Location) const
+{
+	const auto Point = FVector2D(Location.X, Location.Y);
+	auto ClosestPoint = Point;
+	auto ClosestDistanceSquared = TNumericLimits<double>::Max();
+	for (const auto& Polygon : this->Polygons)
+	{
+		const auto Candidate = Polygon.GetClosestPoint(Point);
+		const auto DistanceSquared = FVector2D::DistSquared(Point, Candidate);
+		if (DistanceSquared == 0.0)
+		{
+			return Location;
+		}
+
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestPoint = Candidate;
+		}
+	}
+
+	return FVector(ClosestPoint.X, ClosestPoint.Y, Location.Z);
+}
@@ -0,0 +1,116 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraBoundsSubsystem.h"
+
+#include "RTSCameraBoundsVolume.h"
+#include "Kismet/GameplayStatics.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRTSCameraBoundsSubsystem, Log, All);
+
+void URTSCameraBoundsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Volumes tag themselves too, but they register on their own
+	TArray<AActor*> TaggedActors;
+	UGameplayStatics::GetAllActorsWithTag(&InWorld, FName("OpenRTSCamera#CameraBounds"), TaggedActors);
+	for (const auto Actor : TaggedActors)
+	{
+		if (!Actor->IsA<ARTSCameraBoundsVolume>())
+		{
+			UE_LOG(
+				LogRTSCameraBoundsSubsystem,
+				Warning,
+				TEXT("%s: bounding the camera with the OpenRTSCamera#CameraBounds tag is deprecated, "
+					"use an RTSCameraBoundsVolume instead"),
+				*Actor->GetName()
+			);
+			this->LegacyBoundsActors.Add(Actor);
+		}
+	}
+
+	if (this->LegacyBoundsActors.Num() > 0)
+	{
+		this->RebuildCameraBounds();
+	}
+}
+
+void URTSCameraBoundsSubsystem::RegisterBoundsVolume(ARTSCameraBoundsVolume* Volume)
+{
+	if (Volume == nullptr || this->BoundsVolumes.Contains(Volume))
+	{
+		return;
+	}
+
+	this->BoundsVolumes.Add(Volume);
+	Volume->OnCameraBoundsChanged.AddUObject(this, &URTSCameraBoundsSubsystem::OnBoundsVolumeChanged);
+	this->RebuildCameraBounds();
+}
+
+void URTSCameraBoundsSubsystem::UnregisterBoundsVolume(ARTSCameraBoundsVolume* Volume)
+{
+	if (Volume == nullptr || this->BoundsVolumes.Remove(Volume) == 0)
+	{
+		return;
+	}
+
+	Volume->OnCameraBoundsChanged.RemoveAll(this);
+	this->RebuildCameraBounds();
+}
+
+const FRTSCameraBounds& URTSCameraBoundsSubsystem::GetCameraBounds() const
+{
+	return this->CameraBounds;
+}
+
+bool URTSCameraBoundsSubsystem::SampleHeightfield(const FVector& Location, float& OutHeight) const
+{
+	for (const auto Volume : this->BoundsVolumes)
+	{
+		if (Volume != nullptr && Volume->SampleHeightfield(Location, OutHeight))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void URTSCameraBoundsSubsystem::NotifyHeightfieldInvalidated()
+{
+	this->OnHeightfieldInvalidated.Broadcast();
+}
+
+void URTSCameraBoundsSubsystem::OnBoundsVolumeChanged(ARTSCameraBoundsVolume*)
+{
+	this->RebuildCameraBounds();
+}
+
+void URTSCameraBoundsSubsystem::RebuildCameraBounds()
+{
+	this->CameraBounds.Reset();
+	for (const auto Volume : this->BoundsVolumes)
+	{
+		if (Volume != nullptr)
+		{
+			this->CameraBounds.Append(Volume->GetCameraBounds());
+		}
+	}
+
+	for (const auto Actor : this->LegacyBoundsActors)
+	{
+		if (IsValid(Actor))
+		{
+			FVector Origin;
+			FVector Extents;
+			Actor->GetActorBounds(false, Origin, Extents);
+			this->CameraBounds.AddPolygon(
+				FRTSCameraBoundsPolygon::MakeBox(FBox2D(FVector2D(Origin - Extents), FVector2D(Origin + Extents))),
+				Origin.Z - Extents.Z,
+				Origin.Z + Extents.Z
+			);
+		}
+	}
+
+	this->OnCameraBoundsChanged.Broadcast();
+}
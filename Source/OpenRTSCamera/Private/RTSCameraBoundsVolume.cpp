@@ -1,14 +1,215 @@
 // Copyright 2024 Jesus Bracho All Rights Reserved.
 
 #include "RTSCameraBoundsVolume.h"
+#include "RTSCameraBoundsSubsystem.h"
+#include "RTSCameraHeightfield.h"
+#include "Components/BrushComponent.h"
 #include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogRTSCameraBoundsVolume, Log, All);
 
 ARTSCameraBoundsVolume::ARTSCameraBoundsVolume()
 {
     this->Tags.Add("OpenRTSCamera#CameraBounds");
+    this->Heightfield = nullptr;
+    this->HeightfieldCellSize = 100.0f;
+    this->HeightfieldCollisionChannel = ECC_WorldStatic;
+    this->RuntimeHeightfield = nullptr;
     
     if (UPrimitiveComponent* PrimitiveComponent = this->FindComponentByClass<UPrimitiveComponent>())
     {
         PrimitiveComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName, false);
     }
 }
+
+void ARTSCameraBoundsVolume::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    // Built here rather than in BeginPlay so that the bounds are ready before any camera begins play
+    this->UpdateCameraBounds();
+    if (this->RootComponent != nullptr)
+    {
+        this->RootComponent->TransformUpdated.AddUObject(this, &ARTSCameraBoundsVolume::OnRootTransformUpdated);
+    }
+}
+
+void ARTSCameraBoundsVolume::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (this->Heightfield != nullptr && this->Heightfield->IsBaked())
+    {
+        this->RuntimeHeightfield = DuplicateObject(this->Heightfield, this);
+        this->RuntimeHeightfield->SetRuntimeTraceContext(this->GetWorld(), this);
+    }
+
+    if (const auto Subsystem = this->GetWorld()->GetSubsystem<URTSCameraBoundsSubsystem>())
+    {
+        Subsystem->RegisterBoundsVolume(this);
+    }
+}
+
+void ARTSCameraBoundsVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (const auto Subsystem = this->GetWorld()->GetSubsystem<URTSCameraBoundsSubsystem>())
+    {
+        Subsystem->UnregisterBoundsVolume(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ARTSCameraBoundsVolume::BakeHeightfield()
+{
+#if WITH_EDITOR
+    this->Modify();
+    if (this->Heightfield == nullptr)
+    {
+        this->Heightfield = this->CreateHeightfieldAsset();
+        if (this->Heightfield == nullptr)
+        {
+            return;
+        }
+    }
+
+    FVector Origin;
+    FVector Extents;
+    this->GetActorBounds(false, Origin, Extents);
+
+    this->Heightfield->Modify();
+    this->Heightfield->Bake(
+        this->GetWorld(),
+        FBox(Origin - Extents, Origin + Extents),
+        this->HeightfieldCellSize,
+        this->HeightfieldCollisionChannel,
+        this
+    );
+
+    const auto Package = this->Heightfield->GetOutermost();
+    Package->MarkPackageDirty();
+    if (this->Heightfield->IsAsset())
+    {
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+        const auto Filename = FPackageName::LongPackageNameToFilename(
+            Package->GetName(),
+            FPackageName::GetAssetPackageExtension()
+        );
+        UPackage::SavePackage(Package, this->Heightfield, *Filename, SaveArgs);
+    }
+#endif
+}
+
+#if WITH_EDITOR
+URTSCameraHeightfield* ARTSCameraBoundsVolume::CreateHeightfieldAsset() const
+{
+    const auto LevelPackageName = this->GetLevel()->GetOutermost()->GetName();
+    if (FPackageName::IsTempPackage(LevelPackageName))
+    {
+        UE_LOG(
+            LogRTSCameraBoundsVolume,
+            Warning,
+            TEXT("%s: save the level before baking, the heightfield asset is created next to it"),
+            *this->GetName()
+        );
+        return nullptr;
+    }
+
+    const auto PackageName = FString::Printf(TEXT("%s_%s_Heightfield"), *LevelPackageName, *this->GetName());
+    const auto Package = CreatePackage(*PackageName);
+    const auto Asset = NewObject<URTSCameraHeightfield>(
+        Package,
+        *FPackageName::GetShortName(PackageName),
+        RF_Public | RF_Standalone | RF_Transactional
+    );
+    FAssetRegistryModule::AssetCreated(Asset);
+    return Asset;
+}
+#endif
+
+void ARTSCameraBoundsVolume::InvalidateHeightfield(const FBox& Region)
+{
+    if (this->RuntimeHeightfield != nullptr)
+    {
+        this->RuntimeHeightfield->InvalidateRegion(Region);
+        if (const auto Subsystem = this->GetWorld()->GetSubsystem<URTSCameraBoundsSubsystem>())
+        {
+            Subsystem->NotifyHeightfieldInvalidated();
+        }
+    }
+}
+
+bool ARTSCameraBoundsVolume::SampleHeightfield(const FVector& Location, float& OutHeight) const
+{
+    if (this->RuntimeHeightfield == nullptr || !this->RuntimeHeightfield->ContainsLocation(Location))
+    {
+        return false;
+    }
+
+    OutHeight = this->RuntimeHeightfield->SampleHeight(Location);
+    return true;
+}
+
+const FRTSCameraBounds& ARTSCameraBoundsVolume::GetCameraBounds() const
+{
+    return this->CameraBounds;
+}
+
+void ARTSCameraBoundsVolume::UpdateCameraBounds()
+{
+    this->CameraBounds.Reset();
+
+    // Brushes are made of convex elements, a non-convex brush (e.g. an L-shaped map) has several of them
+    const auto Brush = this->GetBrushComponent();
+    if (Brush != nullptr && Brush->BrushBodySetup != nullptr)
+    {
+        const auto& ComponentTransform = Brush->GetComponentTransform();
+        TArray<FVector2D> Points;
+        for (const auto& ConvexElement : Brush->BrushBodySetup->AggGeom.ConvexElems)
+        {
+            const auto ElementTransform = ConvexElement.GetTransform() * ComponentTransform;
+            auto MinimumZ = TNumericLimits<double>::Max();
+            auto MaximumZ = TNumericLimits<double>::Lowest();
+
+            Points.Reset();
+            for (const auto& Vertex : ConvexElement.VertexData)
+            {
+                const auto WorldVertex = ElementTransform.TransformPosition(Vertex);
+                Points.Add(FVector2D(WorldVertex.X, WorldVertex.Y));
+                MinimumZ = FMath::Min(MinimumZ, WorldVertex.Z);
+                MaximumZ = FMath::Max(MaximumZ, WorldVertex.Z);
+            }
+
+            this->CameraBounds.AddPolygon(FRTSCameraBoundsPolygon::MakeConvexHull(Points), MinimumZ, MaximumZ);
+        }
+    }
+
+    // Fall back to the axis aligned bounds if the brush has no collision geometry
+    if (this->CameraBounds.IsEmpty())
+    {
+        FVector Origin;
+        FVector Extents;
+        this->GetActorBounds(false, Origin, Extents);
+        this->CameraBounds.AddPolygon(
+            FRTSCameraBoundsPolygon::MakeBox(FBox2D(FVector2D(Origin - Extents), FVector2D(Origin + Extents))),
+            Origin.Z - Extents.Z,
+            Origin.Z + Extents.Z
+        );
+    }
+
+    this->OnCameraBoundsChanged.Broadcast(this);
+}
+
+void ARTSCameraBoundsVolume::OnRootTransformUpdated(USceneComponent*, EUpdateTransformFlags, ETeleportType)
+{
+    this->UpdateCameraBounds();
+}
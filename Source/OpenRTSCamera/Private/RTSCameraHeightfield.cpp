@@ -0,0 +1,207 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraHeightfield.h"
+
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRTSCameraHeightfield, Log, All);
+
+void URTSCameraHeightfield::Bake(
+	const UWorld* World,
+	const FBox& Bounds,
+	const float InCellSize,
+	const ECollisionChannel InCollisionChannel,
+	const AActor* ActorToIgnore
+)
+{
+	constexpr int32 MaximumResolution = 4096;
+	const auto Size = Bounds.GetSize();
+
+	// Coarser cells rather than a clamped resolution, which would leave the far side of the bounds uncovered
+	const auto MinimumCellSize = static_cast<float>(FMath::Max(Size.X, Size.Y) / (MaximumResolution - 2));
+	this->Origin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	this->CellSize = FMath::Max(InCellSize, 1.0f);
+	if (this->CellSize < MinimumCellSize)
+	{
+		UE_LOG(
+			LogRTSCameraHeightfield,
+			Warning,
+			TEXT("%s: a cell size of %.1f needs more than %d samples per axis, baking with a cell size of %.1f"),
+			*this->GetPathName(),
+			this->CellSize,
+			MaximumResolution,
+			MinimumCellSize
+		);
+		this->CellSize = MinimumCellSize;
+	}
+	this->Resolution = FIntPoint(
+		FMath::Clamp(FMath::CeilToInt32(Size.X / this->CellSize) + 1, 2, MaximumResolution),
+		FMath::Clamp(FMath::CeilToInt32(Size.Y / this->CellSize) + 1, 2, MaximumResolution)
+	);
+	this->CollisionChannel = InCollisionChannel;
+
+	// Quantize over the whole height of the bounds rather than the baked heights, so that tiles re-traced at
+	// runtime can still represent anything inside the volume
+	this->MinimumHeight = static_cast<float>(Bounds.Min.Z);
+	this->HeightStep = FMath::Max(static_cast<float>(Size.Z), 1.0f) / TNumericLimits<uint16>::Max();
+
+	this->Heights.SetNumUninitialized(this->Resolution.X * this->Resolution.Y);
+	for (int32 Y = 0; Y < this->Resolution.Y; ++Y)
+	{
+		for (int32 X = 0; X < this->Resolution.X; ++X)
+		{
+			this->Heights[Y * this->Resolution.X + X] = this->EncodeHeight(this->TraceHeight(World, ActorToIgnore, X, Y));
+		}
+	}
+
+	this->DirtyTiles.Reset();
+}
+
+bool URTSCameraHeightfield::IsBaked() const
+{
+	return this->Resolution.X >= 2
+		&& this->Resolution.Y >= 2
+		&& this->Heights.Num() == this->Resolution.X * this->Resolution.Y;
+}
+
+bool URTSCameraHeightfield::ContainsLocation(const FVector& Location) const
+{
+	const auto Local = (FVector2D(Location.X, Location.Y) - this->Origin) / this->CellSize;
+	return Local.X >= 0.0 && Local.Y >= 0.0 && Local.X <= this->Resolution.X - 1 && Local.Y <= this->Resolution.Y - 1;
+}
+
+float URTSCameraHeightfield::SampleHeight(const FVector& Location)
+{
+	const auto Local = (FVector2D(Location.X, Location.Y) - this->Origin) / this->CellSize;
+	const auto SampleX = FMath::Clamp(Local.X, 0.0, this->Resolution.X - 1.0);
+	const auto SampleY = FMath::Clamp(Local.Y, 0.0, this->Resolution.Y - 1.0);
+	const auto X0 = FMath::Min(FMath::FloorToInt32(SampleX), this->Resolution.X - 2);
+	const auto Y0 = FMath::Min(FMath::FloorToInt32(SampleY), this->Resolution.Y - 2);
+
+	if (this->DirtyTiles.Num() > 0)
+	{
+		for (auto Y = Y0; Y <= Y0 + 1; ++Y)
+		{
+			for (auto X = X0; X <= X0 + 1; ++X)
+			{
+				const auto TileIndex = this->GetTileIndex(X, Y);
+				if (this->DirtyTiles[TileIndex])
+				{
+					this->RetraceTile(TileIndex);
+				}
+			}
+		}
+	}
+
+	return FMath::BiLerp(
+		this->DecodeHeight(X0, Y0),
+		this->DecodeHeight(X0 + 1, Y0),
+		this->DecodeHeight(X0, Y0 + 1),
+		this->DecodeHeight(X0 + 1, Y0 + 1),
+		static_cast<float>(SampleX - X0),
+		static_cast<float>(SampleY - Y0)
+	);
+}
+
+void URTSCameraHeightfield::InvalidateRegion(const FBox& Region)
+{
+	if (!this->IsBaked())
+	{
+		return;
+	}
+
+	const auto NumTilesX = FMath::DivideAndRoundUp(this->Resolution.X, TileSize);
+	const auto NumTilesY = FMath::DivideAndRoundUp(this->Resolution.Y, TileSize);
+	if (this->DirtyTiles.Num() != NumTilesX * NumTilesY)
+	{
+		this->DirtyTiles.Init(false, NumTilesX * NumTilesY);
+	}
+
+	const auto ToSample = [this](const double Coordinate, const double OriginCoordinate, const int32 Count)
+	{
+		return FMath::Clamp(FMath::FloorToInt32((Coordinate - OriginCoordinate) / this->CellSize), 0, Count - 1);
+	};
+	const auto MinimumX = ToSample(Region.Min.X, this->Origin.X, this->Resolution.X) / TileSize;
+	const auto MaximumX = ToSample(Region.Max.X, this->Origin.X, this->Resolution.X) / TileSize;
+	const auto MinimumY = ToSample(Region.Min.Y, this->Origin.Y, this->Resolution.Y) / TileSize;
+	const auto MaximumY = ToSample(Region.Max.Y, this->Origin.Y, this->Resolution.Y) / TileSize;
+
+	for (auto TileY = MinimumY; TileY <= MaximumY; ++TileY)
+	{
+		for (auto TileX = MinimumX; TileX <= MaximumX; ++TileX)
+		{
+			this->DirtyTiles[TileY * NumTilesX + TileX] = true;
+		}
+	}
+}
+
+void URTSCameraHeightfield::SetRuntimeTraceContext(const UWorld* World, const AActor* ActorToIgnore)
+{
+	this->TraceWorld = World;
+	this->TraceIgnoredActor = ActorToIgnore;
+}
+
+float URTSCameraHeightfield::TraceHeight(
+	const UWorld* World,
+	const AActor* ActorToIgnore,
+	const int32 X,
+	const int32 Y
+) const
+{
+	const auto Top = this->MinimumHeight + this->HeightStep * TNumericLimits<uint16>::Max();
+	const auto SampleLocation = this->Origin + FVector2D(X, Y) * this->CellSize;
+
+	FHitResult HitResult;
+	const auto DidHit = World->LineTraceSingleByChannel(
+		HitResult,
+		FVector(SampleLocation.X, SampleLocation.Y, Top),
+		FVector(SampleLocation.X, SampleLocation.Y, this->MinimumHeight),
+		this->CollisionChannel,
+		FCollisionQueryParams(SCENE_QUERY_STAT(RTSCameraHeightfieldTrace), true, ActorToIgnore)
+	);
+
+	return DidHit ? static_cast<float>(HitResult.Location.Z) : this->MinimumHeight;
+}
+
+float URTSCameraHeightfield::DecodeHeight(const int32 X, const int32 Y) const
+{
+	return this->MinimumHeight + this->Heights[Y * this->Resolution.X + X] * this->HeightStep;
+}
+
+uint16 URTSCameraHeightfield::EncodeHeight(const float Height) const
+{
+	const auto Quantized = FMath::RoundToInt32((Height - this->MinimumHeight) / this->HeightStep);
+	return static_cast<uint16>(FMath::Clamp(Quantized, 0, static_cast<int32>(TNumericLimits<uint16>::Max())));
+}
+
+int32 URTSCameraHeightfield::GetTileIndex(const int32 X, const int32 Y) const
+{
+	return (Y / TileSize) * FMath::DivideAndRoundUp(this->Resolution.X, TileSize) + X / TileSize;
+}
+
+void URTSCameraHeightfield::RetraceTile(const int32 TileIndex)
+{
+	this->DirtyTiles[TileIndex] = false;
+
+	const auto World = this->TraceWorld.Get();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	const auto NumTilesX = FMath::DivideAndRoundUp(this->Resolution.X, TileSize);
+	const auto FirstX = (TileIndex % NumTilesX) * TileSize;
+	const auto FirstY = (TileIndex / NumTilesX) * TileSize;
+	const auto LastX = FMath::Min(FirstX + TileSize, this->Resolution.X);
+	const auto LastY = FMath::Min(FirstY + TileSize, this->Resolution.Y);
+
+	for (auto Y = FirstY; Y < LastY; ++Y)
+	{
+		for (auto X = FirstX; X < LastX; ++X)
+		{
+			this->Heights[Y * this->Resolution.X + X] = this->EncodeHeight(
+				this->TraceHeight(World, this->TraceIgnoredActor.Get(), X, Y)
+			);
+		}
+	}
+}
@@ -0,0 +1,25 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraStats.h"
+
+DEFINE_STAT(STAT_RTSCameraUpdate);
+DEFINE_STAT(STAT_RTSCameraGather);
+DEFINE_STAT(STAT_RTSCameraApplyCommands);
+DEFINE_STAT(STAT_RTSCameraEdgeScroll);
+DEFINE_STAT(STAT_RTSCameraGroundHeight);
+DEFINE_STAT(STAT_RTSCameraZoom);
+DEFINE_STAT(STAT_RTSCameraFollow);
+DEFINE_STAT(STAT_RTSCameraBounds);
+DEFINE_STAT(STAT_RTSCameraCommit);
+
+DEFINE_STAT(STAT_RTSSelectionQuery);
+DEFINE_STAT(STAT_RTSSelectionFilter);
+DEFINE_STAT(STAT_RTSSelectionDiff);
+DEFINE_STAT(STAT_RTSSelectionNotify);
+
+DEFINE_STAT(STAT_RTSCamerasUpdated);
+DEFINE_STAT(STAT_RTSCameraGroundTraces);
+DEFINE_STAT(STAT_RTSCameraMoveCommands);
+DEFINE_STAT(STAT_RTSSelectedActors);
+
+CSV_DEFINE_CATEGORY(OpenRTSCamera, true);
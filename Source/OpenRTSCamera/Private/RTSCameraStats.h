@@ -0,0 +1,35 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+// `stat OpenRTSCamera`
+DECLARE_STATS_GROUP(TEXT("OpenRTSCamera"), STATGROUP_OpenRTSCamera, STATCAT_Advanced);
+
+// Camera update stages, in the order `URTSCameraSubsystem` runs them
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Update"), STAT_RTSCameraUpdate, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Gather"), STAT_RTSCameraGather, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Apply Commands"), STAT_RTSCameraApplyCommands, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Edge Scroll"), STAT_RTSCameraEdgeScroll, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Ground Height"), STAT_RTSCameraGroundHeight, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Zoom Smoothing"), STAT_RTSCameraZoom, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Follow"), STAT_RTSCameraFollow, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Bounds"), STAT_RTSCameraBounds, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Commit"), STAT_RTSCameraCommit, STATGROUP_OpenRTSCamera, );
+
+// Selection phases
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Selection Query"), STAT_RTSSelectionQuery, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Selection Filter"), STAT_RTSSelectionFilter, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Selection Diff"), STAT_RTSSelectionDiff, STATGROUP_OpenRTSCamera, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Selection Notify"), STAT_RTSSelectionNotify, STATGROUP_OpenRTSCamera, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cameras Updated"), STAT_RTSCamerasUpdated, STATGROUP_OpenRTSCamera, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Traces"), STAT_RTSCameraGroundTraces, STATGROUP_OpenRTSCamera, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Commands"), STAT_RTSCameraMoveCommands, STATGROUP_OpenRTSCamera, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Selected Actors"), STAT_RTSSelectedActors, STATGROUP_OpenRTSCamera, );
+
+CSV_DECLARE_CATEGORY_EXTERN(OpenRTSCamera);
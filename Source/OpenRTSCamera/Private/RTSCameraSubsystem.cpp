@@ -0,0 +1,170 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSCameraSubsystem.h"
+
+#include "RTSCameraStats.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void FRTSCameraSubsystemTickFunction::ExecuteTick(
+	const float DeltaTime,
+	ELevelTick,
+	ENamedThreads::Type,
+	const FGraphEventRef&
+)
+{
+	if (this->Target != nullptr)
+	{
+		this->Target->Tick(DeltaTime);
+	}
+}
+
+FString FRTSCameraSubsystemTickFunction::DiagnosticMessage()
+{
+	return TEXT("URTSCameraSubsystem::Tick");
+}
+
+FName FRTSCameraSubsystemTickFunction::DiagnosticContext(bool)
+{
+	return FName(TEXT("URTSCameraSubsystem"));
+}
+
+void URTSCameraSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Cameras never register on a dedicated server
+	if (InWorld.GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	this->TickFunction.Target = this;
+	this->TickFunction.TickGroup = TG_PrePhysics;
+	this->TickFunction.bCanEverTick = true;
+	this->TickFunction.bStartWithTickEnabled = true;
+	this->TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void URTSCameraSubsystem::Deinitialize()
+{
+	if (this->TickFunction.IsTickFunctionRegistered())
+	{
+		this->TickFunction.UnRegisterTickFunction();
+	}
+	this->TickFunction.Target = nullptr;
+
+	Super::Deinitialize();
+}
+
+void URTSCameraSubsystem::RegisterCamera(URTSCamera* Camera)
+{
+	if (Camera != nullptr && !this->Cameras.Contains(Camera))
+	{
+		this->Cameras.Add(Camera);
+		this->States.AddDefaulted();
+
+		// Input is consumed by the player controller's tick, the cameras have to run after it to see it this frame
+		if (Camera->PlayerController != nullptr)
+		{
+			this->TickFunction.AddPrerequisite(Camera->PlayerController, Camera->PlayerController->PrimaryActorTick);
+		}
+	}
+}
+
+void URTSCameraSubsystem::UnregisterCamera(URTSCamera* Camera)
+{
+	const auto Index = this->Cameras.Find(Camera);
+	if (Index != INDEX_NONE)
+	{
+		this->Cameras.RemoveAtSwap(Index, 1, false);
+		this->States.RemoveAtSwap(Index, 1, false);
+
+		// Keep waiting on the player controller as long as another camera still reads input from it
+		const auto PlayerController = Camera->PlayerController;
+		const auto SharesPlayerController = [PlayerController](const URTSCamera* Other)
+		{
+			return Other->PlayerController == PlayerController;
+		};
+		if (PlayerController != nullptr && !this->Cameras.ContainsByPredicate(SharesPlayerController))
+		{
+			this->TickFunction.RemovePrerequisite(PlayerController, PlayerController->PrimaryActorTick);
+		}
+	}
+}
+
+void URTSCameraSubsystem::Tick(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSCameraUpdate);
+	TRACE_CPUPROFILER_EVENT_SCOPE(URTSCameraSubsystem::Tick);
+	CSV_SCOPED_TIMING_STAT(OpenRTSCamera, CameraUpdate);
+
+	this->ActiveIndices.Reset();
+	for (int32 Index = 0; Index < this->Cameras.Num(); ++Index)
+	{
+		const auto Camera = this->Cameras[Index];
+		if (Camera != nullptr && Camera->GatherCameraState(this->States[Index], DeltaTime))
+		{
+			this->ActiveIndices.Add(Index);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_RTSCamerasUpdated, this->ActiveIndices.Num());
+	CSV_CUSTOM_STAT(OpenRTSCamera, CamerasUpdated, this->ActiveIndices.Num(), ECsvCustomStatOp::Set);
+
+	if (this->ActiveIndices.Num() == 0)
+	{
+		return;
+	}
+
+	const auto IsParallel = this->ActiveIndices.Num() >= ParallelUpdateThreshold;
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URTSCameraSubsystem::UpdateCameraMovement);
+		this->ForEachActiveCamera([](URTSCamera& Camera, FRTSCameraState& State)
+		{
+			Camera.UpdateCameraMovement(State);
+		}, IsParallel);
+	}
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URTSCameraSubsystem::KeepCamerasAboveGround);
+		this->ForEachActiveCamera([](URTSCamera& Camera, FRTSCameraState& State)
+		{
+			Camera.ConditionallyKeepCameraAtDesiredZoomAboveGround(State);
+		}, false);
+	}
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URTSCameraSubsystem::UpdateCameraFraming);
+		this->ForEachActiveCamera([](URTSCamera& Camera, FRTSCameraState& State)
+		{
+			Camera.UpdateCameraFraming(State);
+		}, IsParallel);
+	}
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URTSCameraSubsystem::CommitCameraStates);
+		this->ForEachActiveCamera([](URTSCamera& Camera, FRTSCameraState& State)
+		{
+			Camera.ConditionallyFallAsleep(Camera.CommitCameraState(State));
+		}, false);
+	}
+}
+
+void URTSCameraSubsystem::ForEachActiveCamera(
+	const TFunctionRef<void(URTSCamera&, FRTSCameraState&)> Stage,
+	const bool IsParallel
+)
+{
+	ParallelFor(
+		this->ActiveIndices.Num(),
+		[this, Stage](const int32 ActiveIndex)
+		{
+			const auto Index = this->ActiveIndices[ActiveIndex];
+			Stage(*this->Cameras[Index], this->States[Index]);
+		},
+		IsParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread
+	);
+}
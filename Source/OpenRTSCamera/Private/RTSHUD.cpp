@@ -8,7 +8,6 @@ ARTSHUD::ARTSHUD()
 	SelectionBoxColor = FLinearColor::Green;
 	SelectionBoxThickness = 1.0f;
 	bIsDrawingSelectionBox = false;
-	bIsPerformingSelection = false;
 }
 
 // Implementation of the DrawHUD function. It's called every frame to draw the HUD.
@@ -21,12 +20,6 @@ void ARTSHUD::DrawHUD()
 	{
 		DrawSelectionBox(SelectionStart, SelectionEnd);
 	}
-
-	// Perform selection actions if required.
-	if (bIsPerformingSelection)
-	{
-		PerformSelection();
-	}
 }
 
 // Starts the selection process, setting the initial point and activating the selection flag.
@@ -42,11 +35,10 @@ void ARTSHUD::UpdateSelection(const FVector2D& EndPoint)
 	SelectionEnd = EndPoint;
 }
 
-// Ends the selection process and triggers the selection logic.
+// Ends the selection process. The selection itself is resolved by URTSSelector in the same frame.
 void ARTSHUD::EndSelection()
 {
 	bIsDrawingSelectionBox = false;
-	bIsPerformingSelection = true;
 }
 
 // Default implementation of DrawSelectionBox. Draws a rectangle on the HUD.
@@ -66,21 +58,14 @@ void ARTSHUD::DrawSelectionBox_Implementation(const FVector2D& StartPoint, const
 	}
 }
 
-// Default implementation of PerformSelection. Selects actors within the selection box.
+// Default implementation of PerformSelection. Forwards the selection box to the player's selector.
 void ARTSHUD::PerformSelection_Implementation()
 {
-	// Array to store actors that are within the selection rectangle.
-	TArray<AActor*> SelectedActors;
-	GetActorsInSelectionRectangle<AActor>(SelectionStart, SelectionEnd, SelectedActors, false, false);
-
-	// Find the URTSSelector component and pass the selected actors to it.
 	if (const auto PC = GetOwningPlayerController())
 	{
 		if (const auto SelectorComponent = PC->FindComponentByClass<URTSSelector>())
 		{
-			SelectorComponent->HandleSelectedActors(SelectedActors);
+			SelectorComponent->SelectInScreenRectangle(SelectionStart, SelectionEnd);
 		}
 	}
-
-	bIsPerformingSelection = false;
 }
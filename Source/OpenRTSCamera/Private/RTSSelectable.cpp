@@ -1 +1,123 @@
 ﻿#include "RTSSelectable.h"
+
+#include "RTSSelectionFilter.h"
+#include "RTSSelectionSubsystem.h"
+#include "Engine/World.h"
+
+void URTSSelectable::OnRegister()
+{
+	Super::OnRegister();
+
+	if (const auto World = this->GetWorld(); World && World->IsGameWorld())
+	{
+		if (const auto Subsystem = World->GetSubsystem<URTSSelectionSubsystem>())
+		{
+			this->RegistrySlot = Subsystem->RegisterSelectable(this);
+		}
+
+		// Keep the selection grid current as the owner moves
+		if (const auto Root = this->GetOwner()->GetRootComponent())
+		{
+			this->OwnerTransformUpdatedHandle = Root->TransformUpdated.AddUObject(
+				this,
+				&URTSSelectable::OnOwnerTransformUpdated
+			);
+		}
+	}
+}
+
+void URTSSelectable::OnUnregister()
+{
+	if (const auto Root = this->GetOwner()->GetRootComponent())
+	{
+		Root->TransformUpdated.Remove(this->OwnerTransformUpdatedHandle);
+	}
+	this->OwnerTransformUpdatedHandle.Reset();
+
+	if (const auto World = this->GetWorld())
+	{
+		if (const auto Subsystem = World->GetSubsystem<URTSSelectionSubsystem>())
+		{
+			Subsystem->UnregisterSelectable(this->RegistrySlot);
+		}
+	}
+	this->RegistrySlot = INDEX_NONE;
+
+	Super::OnUnregister();
+}
+
+void URTSSelectable::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Every component of the owner is registered by now, so its bounds are meaningful
+	this->RefreshSelectionBounds();
+}
+
+void URTSSelectable::RefreshSelectionBounds()
+{
+	const auto Subsystem = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	if (Subsystem == nullptr || this->RegistrySlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	// The radius is measured from the actor location so that it stays valid as the owner moves. Components without
+	// collision count too, since picks and box selection test these bounds rather than the collision
+	const auto Bounds = this->GetOwner()->GetComponentsBoundingBox(true);
+	const auto BoundsRadius = Bounds.IsValid
+		? (Bounds.GetCenter() - this->GetOwner()->GetActorLocation()).Size() + Bounds.GetExtent().Size()
+		: 0.0;
+
+	Subsystem->UpdateSelectableBoundsRadius(this->RegistrySlot, static_cast<float>(BoundsRadius));
+	Subsystem->UpdateSelectableLocation(this->RegistrySlot, this->GetOwner()->GetActorLocation());
+}
+
+int32 URTSSelectable::GetRegistrySlot() const
+{
+	return this->RegistrySlot;
+}
+
+void URTSSelectable::SetSelectable(const bool InIsSelectable)
+{
+	this->IsSelectable = InIsSelectable;
+	this->UpdateRegistryFilterBits();
+}
+
+void URTSSelectable::SetTeamId(const uint8 InTeamId)
+{
+	this->TeamId = InTeamId;
+	this->UpdateRegistryFilterBits();
+}
+
+void URTSSelectable::SetCategoryMask(const int32 InCategoryMask)
+{
+	this->CategoryMask = InCategoryMask;
+	this->UpdateRegistryFilterBits();
+}
+
+uint64 URTSSelectable::GetSelectionFilterBits() const
+{
+	return FRTSSelectionFilter::PackSelectableBits(this->TeamId, this->CategoryMask, this->IsSelectable);
+}
+
+void URTSSelectable::UpdateRegistryFilterBits() const
+{
+	const auto World = this->GetWorld();
+	if (const auto Subsystem = World ? World->GetSubsystem<URTSSelectionSubsystem>() : nullptr)
+	{
+		Subsystem->UpdateSelectableFilterBits(this->RegistrySlot, this->GetSelectionFilterBits());
+	}
+}
+
+void URTSSelectable::OnOwnerTransformUpdated(
+	USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags,
+	ETeleportType
+)
+{
+	if (const auto Subsystem = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>())
+	{
+		Subsystem->UpdateSelectableLocation(this->RegistrySlot, UpdatedComponent->GetComponentLocation());
+	}
+}
@@ -0,0 +1,148 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSSelectionFrustum.h"
+
+#include "Math/VectorRegister.h"
+
+FRTSSelectionFrustum::FRTSSelectionFrustum(
+	const FVector (&InCornerOrigins)[4],
+	const FVector (&InCornerDirections)[4]
+)
+{
+	auto CenterOrigin = FVector::ZeroVector;
+	auto CenterDirection = FVector::ZeroVector;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		this->CornerOrigins[Index] = InCornerOrigins[Index];
+		this->CornerDirections[Index] = InCornerDirections[Index];
+		CenterOrigin += InCornerOrigins[Index] * 0.25;
+		CenterDirection += InCornerDirections[Index] * 0.25;
+	}
+
+	// Each side plane contains one corner ray and a point on the next one, which covers both perspective (shared
+	// origin) and orthographic (shared direction) projections.
+	const auto InsidePoint = CenterOrigin + CenterDirection;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		const auto Next = (Index + 1) % 4;
+		const auto& Origin = InCornerOrigins[Index];
+		const auto Normal = FVector::CrossProduct(
+			InCornerDirections[Index],
+			InCornerOrigins[Next] + InCornerDirections[Next] - Origin
+		).GetSafeNormal();
+
+		this->Planes[Index] = FPlane(Origin, Normal);
+		if (this->Planes[Index].PlaneDot(InsidePoint) < 0.0)
+		{
+			this->Planes[Index] = this->Planes[Index].Flip();
+		}
+	}
+}
+
+FBox2D FRTSSelectionFrustum::MakeScreenRectangle(const FVector2D& A, const FVector2D& B)
+{
+	// A click without a drag still has to span a proper frustum
+	const auto Min = FVector2D::Min(A, B);
+	const auto Max = FVector2D::Max(FVector2D::Max(A, B), Min + FVector2D(1.0, 1.0));
+	return FBox2D(Min, Max);
+}
+
+void FRTSSelectionFrustum::GetScreenRectangleCorners(const FBox2D& Rectangle, FVector2D (&OutCorners)[4])
+{
+	OutCorners[0] = Rectangle.Min;
+	OutCorners[1] = FVector2D(Rectangle.Max.X, Rectangle.Min.Y);
+	OutCorners[2] = Rectangle.Max;
+	OutCorners[3] = FVector2D(Rectangle.Min.X, Rectangle.Max.Y);
+}
+
+bool FRTSSelectionFrustum::IntersectsSphere(const FVector& Center, const float Radius) const
+{
+	for (const auto& Plane : this->Planes)
+	{
+		if (Plane.PlaneDot(Center) < -Radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FRTSSelectionFrustum::CullSpheres(
+	const float* X,
+	const float* Y,
+	const float* Z,
+	const float* Radius,
+	const int32 Count,
+	TArray<int32>& OutIndices
+) const
+{
+	VectorRegister4Float NormalX[4];
+	VectorRegister4Float NormalY[4];
+	VectorRegister4Float NormalZ[4];
+	VectorRegister4Float NegatedW[4];
+	for (int32 PlaneIndex = 0; PlaneIndex < 4; ++PlaneIndex)
+	{
+		const auto& Plane = this->Planes[PlaneIndex];
+		NormalX[PlaneIndex] = VectorSetFloat1(static_cast<float>(Plane.X));
+		NormalY[PlaneIndex] = VectorSetFloat1(static_cast<float>(Plane.Y));
+		NormalZ[PlaneIndex] = VectorSetFloat1(static_cast<float>(Plane.Z));
+		NegatedW[PlaneIndex] = VectorSetFloat1(static_cast<float>(-Plane.W));
+	}
+
+	const auto Zero = VectorZeroFloat();
+	const auto NumVectorized = Count & ~3;
+	for (int32 Index = 0; Index < NumVectorized; Index += 4)
+	{
+		const auto PointX = VectorLoad(X + Index);
+		const auto PointY = VectorLoad(Y + Index);
+		const auto PointZ = VectorLoad(Z + Index);
+		const auto PointRadius = VectorLoad(Radius + Index);
+
+		// Distance + radius >= 0 against every plane, accumulated as a lane mask.
+		const auto IsInsidePlane = [&](const int32 PlaneIndex)
+		{
+			auto Distance = VectorMultiplyAdd(PointX, NormalX[PlaneIndex], NegatedW[PlaneIndex]);
+			Distance = VectorMultiplyAdd(PointY, NormalY[PlaneIndex], Distance);
+			Distance = VectorMultiplyAdd(PointZ, NormalZ[PlaneIndex], Distance);
+			return VectorCompareGE(VectorAdd(Distance, PointRadius), Zero);
+		};
+		const auto Inside = VectorBitwiseAnd(
+			VectorBitwiseAnd(IsInsidePlane(0), IsInsidePlane(1)),
+			VectorBitwiseAnd(IsInsidePlane(2), IsInsidePlane(3))
+		);
+
+		for (auto Mask = static_cast<uint32>(VectorMaskBits(Inside)); Mask != 0; Mask &= Mask - 1)
+		{
+			OutIndices.Add(Index + static_cast<int32>(FMath::CountTrailingZeros(Mask)));
+		}
+	}
+
+	this->CullSpheresScalar(
+		X + NumVectorized,
+		Y + NumVectorized,
+		Z + NumVectorized,
+		Radius + NumVectorized,
+		Count - NumVectorized,
+		OutIndices,
+		NumVectorized
+	);
+}
+
+void FRTSSelectionFrustum::CullSpheresScalar(
+	const float* X,
+	const float* Y,
+	const float* Z,
+	const float* Radius,
+	const int32 Count,
+	TArray<int32>& OutIndices,
+	const int32 FirstIndex
+) const
+{
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (this->IntersectsSphere(FVector(X[Index], Y[Index], Z[Index]), Radius[Index]))
+		{
+			OutIndices.Add(FirstIndex + Index);
+		}
+	}
+}
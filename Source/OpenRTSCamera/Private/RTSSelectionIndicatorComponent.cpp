@@ -0,0 +1,125 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSSelectionIndicatorComponent.h"
+
+#include "RTSSelectable.h"
+#include "RTSSelectionSubsystem.h"
+#include "Engine/World.h"
+
+URTSSelectionIndicatorComponent::URTSSelectionIndicatorComponent()
+{
+	this->IndicatorRadiusScale = 1.0f;
+	this->IndicatorMeshRadius = 50.0f;
+	this->IndicatorOffset = FVector::ZeroVector;
+
+	// Units move during the frame, so follow them once they are done
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	this->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	this->SetGenerateOverlapEvents(false);
+	this->SetCastShadow(false);
+}
+
+void URTSSelectionIndicatorComponent::TickComponent(
+	const float DeltaTime,
+	const ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction
+)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (this->RefreshInstanceTransforms())
+	{
+		this->BatchUpdateInstancesTransforms(0, this->InstanceTransforms, true, true);
+	}
+}
+
+void URTSSelectionIndicatorComponent::OnSelectablesSelected(const TConstArrayView<URTSSelectable*> Selectables)
+{
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+
+	this->NewInstanceTransforms.Reset();
+	for (const auto Selectable : Selectables)
+	{
+		if (IsValid(Selectable))
+		{
+			this->IndicatedSelectables.Add(Selectable);
+			this->NewInstanceTransforms.Add(this->MakeIndicatorTransform(Registry, Selectable));
+		}
+	}
+
+	this->InstanceTransforms.Append(this->NewInstanceTransforms);
+	this->AddInstances(this->NewInstanceTransforms, false, true);
+	this->SetComponentTickEnabled(this->IndicatedSelectables.Num() > 0);
+}
+
+void URTSSelectionIndicatorComponent::OnSelectablesDeselected(const TConstArrayView<URTSSelectable*> Selectables)
+{
+	this->DeselectedSelectables.Reset();
+	for (const auto Selectable : Selectables)
+	{
+		this->DeselectedSelectables.Add(Selectable);
+	}
+
+	// Fill each hole with the last instance, so that only the removed instances and the ones moved into their place
+	// are touched. Walking backwards, the last instance has always been kept already
+	for (int32 Index = this->IndicatedSelectables.Num() - 1; Index >= 0; --Index)
+	{
+		const auto Selectable = this->IndicatedSelectables[Index];
+		if (IsValid(Selectable) && !this->DeselectedSelectables.Contains(Selectable))
+		{
+			continue;
+		}
+
+		const auto LastIndex = this->IndicatedSelectables.Num() - 1;
+		if (Index != LastIndex)
+		{
+			this->UpdateInstanceTransform(Index, this->InstanceTransforms[LastIndex], true);
+		}
+		this->RemoveInstance(LastIndex);
+		this->IndicatedSelectables.RemoveAtSwap(Index, 1, false);
+		this->InstanceTransforms.RemoveAtSwap(Index, 1, false);
+	}
+
+	this->SetComponentTickEnabled(this->IndicatedSelectables.Num() > 0);
+}
+
+FTransform URTSSelectionIndicatorComponent::MakeIndicatorTransform(
+	const URTSSelectionSubsystem* Registry,
+	const URTSSelectable* Selectable
+) const
+{
+	const auto Slot = IsValid(Selectable) ? Selectable->GetRegistrySlot() : INDEX_NONE;
+	if (Registry == nullptr || !Registry->IsValidSlot(Slot))
+	{
+		// Collapsed until the selection catches up with the selectable going away
+		return FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+	}
+
+	// Owners without any primitive component have no bounds, they get a ring of the mesh's own radius instead
+	const auto BoundsRadius = Registry->GetBoundsRadius(Slot);
+	const auto Radius = BoundsRadius > 0.0f ? BoundsRadius : this->IndicatorMeshRadius;
+	const auto Scale = Radius * this->IndicatorRadiusScale
+		/ FMath::Max(this->IndicatorMeshRadius, UE_KINDA_SMALL_NUMBER);
+	return FTransform(FQuat::Identity, Registry->GetLocation(Slot) + this->IndicatorOffset, FVector(Scale, Scale, 1.0));
+}
+
+bool URTSSelectionIndicatorComponent::RefreshInstanceTransforms()
+{
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+
+	auto HasChanged = false;
+	for (int32 Index = 0; Index < this->IndicatedSelectables.Num(); ++Index)
+	{
+		const auto Transform = this->MakeIndicatorTransform(Registry, this->IndicatedSelectables[Index]);
+		if (!Transform.Equals(this->InstanceTransforms[Index]))
+		{
+			this->InstanceTransforms[Index] = Transform;
+			HasChanged = true;
+		}
+	}
+
+	return HasChanged;
+}
@@ -0,0 +1,125 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSSelectionSet.h"
+
+bool FRTSSelectionSet::Add(const URTSSelectionSubsystem& Registry, const FRTSSelectableHandle Handle)
+{
+	this->Prune(Registry);
+
+	const auto Slot = Registry.ResolveHandle(Handle);
+	if (Slot == INDEX_NONE || this->IsMember(Handle))
+	{
+		return false;
+	}
+
+	if (this->MemberSlots.Num() <= Slot)
+	{
+		const auto NumBits = FMath::Max(Slot + 1, Registry.GetSlotCapacity());
+		this->MemberSlots.Add(false, NumBits - this->MemberSlots.Num());
+		this->TombstoneSlots.Add(false, NumBits - this->TombstoneSlots.Num());
+	}
+
+	// A slot must not have both a tombstone and a live entry, otherwise iteration would see it twice
+	if (this->TombstoneSlots[Slot] || this->NumTombstones * 2 > this->Handles.Num())
+	{
+		this->Compact(nullptr);
+	}
+
+	this->Handles.Add(Handle);
+	this->MemberSlots[Slot] = true;
+	return true;
+}
+
+bool FRTSSelectionSet::Remove(const FRTSSelectableHandle Handle)
+{
+	if (!this->IsMember(Handle))
+	{
+		return false;
+	}
+
+	const auto Slot = Handle.GetSlot();
+	this->MemberSlots[Slot] = false;
+	this->TombstoneSlots[Slot] = true;
+	++this->NumTombstones;
+	return true;
+}
+
+bool FRTSSelectionSet::Contains(const URTSSelectionSubsystem& Registry, const FRTSSelectableHandle Handle) const
+{
+	if (!this->IsMember(Handle) || Registry.ResolveHandle(Handle) == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// The slot may have been reused since the last prune, in which case only the exact handle counts
+	return this->PrunedNumRemovals == Registry.GetNumRemovals() || this->Handles.Contains(Handle);
+}
+
+void FRTSSelectionSet::Reset()
+{
+	this->Handles.Reset();
+	this->MemberSlots.Init(false, this->MemberSlots.Num());
+	this->TombstoneSlots.Init(false, this->TombstoneSlots.Num());
+	this->NumTombstones = 0;
+}
+
+void FRTSSelectionSet::Prune(const URTSSelectionSubsystem& Registry)
+{
+	if (this->PrunedNumRemovals != Registry.GetNumRemovals())
+	{
+		this->Compact(&Registry);
+		this->PrunedNumRemovals = Registry.GetNumRemovals();
+	}
+}
+
+int32 FRTSSelectionSet::Num() const
+{
+	return this->Handles.Num() - this->NumTombstones;
+}
+
+bool FRTSSelectionSet::IsEmpty() const
+{
+	return this->Num() == 0;
+}
+
+TConstArrayView<FRTSSelectableHandle> FRTSSelectionSet::GetHandles() const
+{
+	return this->Handles;
+}
+
+bool FRTSSelectionSet::IsMember(const FRTSSelectableHandle Handle) const
+{
+	const auto Slot = Handle.GetSlot();
+	return Handle.IsSet() && Slot < this->MemberSlots.Num() && this->MemberSlots[Slot];
+}
+
+SIZE_T FRTSSelectionSet::GetAllocatedSize() const
+{
+	return this->Handles.GetAllocatedSize()
+		+ this->MemberSlots.GetAllocatedSize()
+		+ this->TombstoneSlots.GetAllocatedSize();
+}
+
+void FRTSSelectionSet::Compact(const URTSSelectionSubsystem* Registry)
+{
+	auto NumRemaining = 0;
+	for (const auto Handle : this->Handles)
+	{
+		const auto Slot = Handle.GetSlot();
+		if (!this->MemberSlots[Slot])
+		{
+			this->TombstoneSlots[Slot] = false;
+		}
+		else if (Registry != nullptr && Registry->ResolveHandle(Handle) == INDEX_NONE)
+		{
+			this->MemberSlots[Slot] = false;
+		}
+		else
+		{
+			this->Handles[NumRemaining++] = Handle;
+		}
+	}
+
+	this->Handles.SetNum(NumRemaining, false);
+	this->NumTombstones = 0;
+}
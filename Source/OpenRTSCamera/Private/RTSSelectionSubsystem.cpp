@@ -0,0 +1,579 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSSelectionSubsystem.h"
+
+#include "RTSSelectable.h"
+#include "GameFramework/Actor.h"
+
+URTSSelectionSubsystem::URTSSelectionSubsystem()
+{
+	this->GridCellSize = 2000.0f;
+	this->MinimumZ = TNumericLimits<float>::Max();
+	this->MaximumZ = TNumericLimits<float>::Lowest();
+	this->MaximumBoundsRadius = 0.0f;
+	this->NumRemovals = 0;
+}
+
+int32 URTSSelectionSubsystem::RegisterSelectable(URTSSelectable* Selectable)
+{
+	const auto Owner = Selectable != nullptr ? Selectable->GetOwner() : nullptr;
+	if (Owner == nullptr || this->OwnerToSlot.Contains(Owner))
+	{
+		return INDEX_NONE;
+	}
+
+	if (this->FreeSlots.Num() == 0 && !ensureMsgf(
+		this->SlotToDense.Num() <= static_cast<int32>(FRTSSelectableHandle::SlotMask),
+		TEXT("URTSSelectionSubsystem ran out of selectable handles")
+	))
+	{
+		return INDEX_NONE;
+	}
+
+	auto Slot = INDEX_NONE;
+	if (this->FreeSlots.Num() > 0)
+	{
+		Slot = this->FreeSlots.Pop(false);
+	}
+	else
+	{
+		Slot = this->SlotToDense.AddUninitialized();
+		this->SlotGenerations.Add(1);
+		this->SlotToClassIndex.AddUninitialized();
+	}
+
+	const auto DenseIndex = this->Selectables.Add(Selectable);
+	const auto Location = Owner->GetActorLocation();
+	const auto Cell = this->GetCell(Location);
+
+	this->Owners.Add(Owner);
+	this->LocationsX.Add(static_cast<float>(Location.X));
+	this->LocationsY.Add(static_cast<float>(Location.Y));
+	this->LocationsZ.Add(static_cast<float>(Location.Z));
+	this->BoundsRadii.Add(0.0f);
+	this->FilterBits.Add(Selectable->GetSelectionFilterBits());
+	this->DenseCells.Add(Cell);
+	this->DenseToSlot.Add(Slot);
+	this->SlotToDense[Slot] = DenseIndex;
+	this->OwnerToSlot.Add(Owner, Slot);
+	this->AddToCell(Cell, Slot);
+	this->SlotToClassIndex[Slot] = this->ClassToSlots.FindOrAdd(Owner->GetClass()).Add(Slot);
+
+	this->MinimumZ = FMath::Min(this->MinimumZ, static_cast<float>(Location.Z));
+	this->MaximumZ = FMath::Max(this->MaximumZ, static_cast<float>(Location.Z));
+
+	return Slot;
+}
+
+void URTSSelectionSubsystem::UnregisterSelectable(const int32 Slot)
+{
+	if (!this->IsValidSlot(Slot))
+	{
+		return;
+	}
+
+	const auto DenseIndex = this->SlotToDense[Slot];
+	this->RemoveFromCell(this->DenseCells[DenseIndex], Slot);
+	this->OwnerToSlot.Remove(this->Owners[DenseIndex]);
+
+	const auto Class = this->Owners[DenseIndex]->GetClass();
+	if (auto* ClassSlots = this->ClassToSlots.Find(Class))
+	{
+		const auto ClassIndex = this->SlotToClassIndex[Slot];
+		ClassSlots->RemoveAtSwap(ClassIndex, 1, false);
+		if (ClassIndex < ClassSlots->Num())
+		{
+			this->SlotToClassIndex[(*ClassSlots)[ClassIndex]] = ClassIndex;
+		}
+		if (ClassSlots->IsEmpty())
+		{
+			this->ClassToSlots.Remove(Class);
+		}
+	}
+
+	// Swap the last element into the hole to keep the arrays dense, then patch the moved slot.
+	this->Selectables.RemoveAtSwap(DenseIndex, 1, false);
+	this->Owners.RemoveAtSwap(DenseIndex, 1, false);
+	this->LocationsX.RemoveAtSwap(DenseIndex, 1, false);
+	this->LocationsY.RemoveAtSwap(DenseIndex, 1, false);
+	this->LocationsZ.RemoveAtSwap(DenseIndex, 1, false);
+	this->BoundsRadii.RemoveAtSwap(DenseIndex, 1, false);
+	this->FilterBits.RemoveAtSwap(DenseIndex, 1, false);
+	this->DenseCells.RemoveAtSwap(DenseIndex, 1, false);
+	this->DenseToSlot.RemoveAtSwap(DenseIndex, 1, false);
+	if (DenseIndex < this->DenseToSlot.Num())
+	{
+		this->SlotToDense[this->DenseToSlot[DenseIndex]] = DenseIndex;
+	}
+
+	this->SlotToDense[Slot] = INDEX_NONE;
+	this->FreeSlots.Push(Slot);
+
+	// Invalidate every handle to the slot, wrapping around to 1 because 0 is reserved for unset handles
+	auto& Generation = this->SlotGenerations[Slot];
+	Generation = Generation < FRTSSelectableHandle::MaxGeneration ? Generation + 1 : 1;
+	++this->NumRemovals;
+}
+
+void URTSSelectionSubsystem::UpdateSelectableLocation(const int32 Slot, const FVector& Location)
+{
+	if (!this->IsValidSlot(Slot))
+	{
+		return;
+	}
+
+	const auto DenseIndex = this->SlotToDense[Slot];
+	this->LocationsX[DenseIndex] = static_cast<float>(Location.X);
+	this->LocationsY[DenseIndex] = static_cast<float>(Location.Y);
+	this->LocationsZ[DenseIndex] = static_cast<float>(Location.Z);
+	this->MinimumZ = FMath::Min(this->MinimumZ, static_cast<float>(Location.Z));
+	this->MaximumZ = FMath::Max(this->MaximumZ, static_cast<float>(Location.Z));
+
+	const auto Cell = this->GetCell(Location);
+	if (Cell != this->DenseCells[DenseIndex])
+	{
+		this->RemoveFromCell(this->DenseCells[DenseIndex], Slot);
+		this->AddToCell(Cell, Slot);
+		this->DenseCells[DenseIndex] = Cell;
+	}
+}
+
+void URTSSelectionSubsystem::UpdateSelectableBoundsRadius(const int32 Slot, const float BoundsRadius)
+{
+	if (this->IsValidSlot(Slot))
+	{
+		this->BoundsRadii[this->SlotToDense[Slot]] = BoundsRadius;
+		this->MaximumBoundsRadius = FMath::Max(this->MaximumBoundsRadius, BoundsRadius);
+	}
+}
+
+void URTSSelectionSubsystem::UpdateSelectableFilterBits(const int32 Slot, const uint64 InFilterBits)
+{
+	if (this->IsValidSlot(Slot))
+	{
+		this->FilterBits[this->SlotToDense[Slot]] = InFilterBits;
+	}
+}
+
+void URTSSelectionSubsystem::QuerySelectablesInFrustum(
+	const FRTSSelectionFrustum& Frustum,
+	TArray<int32>& OutSlots
+) const
+{
+	this->ScratchSlots.Reset();
+	this->ScratchIndices.Reset();
+	this->GatherSelectablesInFrustum(Frustum, this->ScratchSlots);
+
+	// Once the grid does not cull much, testing the dense arrays directly beats gathering the candidates.
+	if (this->ScratchSlots.Num() * 2 > this->Selectables.Num())
+	{
+		Frustum.CullSpheres(
+			this->LocationsX.GetData(),
+			this->LocationsY.GetData(),
+			this->LocationsZ.GetData(),
+			this->BoundsRadii.GetData(),
+			this->Selectables.Num(),
+			this->ScratchIndices
+		);
+
+		OutSlots.Reserve(OutSlots.Num() + this->ScratchIndices.Num());
+		for (const auto DenseIndex : this->ScratchIndices)
+		{
+			OutSlots.Add(this->DenseToSlot[DenseIndex]);
+		}
+		return;
+	}
+
+	this->CullCandidateSlots(Frustum, this->ScratchSlots, OutSlots);
+}
+
+void URTSSelectionSubsystem::QuerySelectablesOfClassInFrustum(
+	const UClass* Class,
+	const FRTSSelectionFrustum& Frustum,
+	TArray<int32>& OutSlots
+) const
+{
+	this->CullCandidateSlots(Frustum, this->GetSlotsOfClass(Class), OutSlots);
+}
+
+TConstArrayView<int32> URTSSelectionSubsystem::GetSlotsOfClass(const UClass* Class) const
+{
+	const auto* ClassSlots = this->ClassToSlots.Find(Class);
+	return ClassSlots != nullptr ? TConstArrayView<int32>(*ClassSlots) : TConstArrayView<int32>();
+}
+
+void URTSSelectionSubsystem::GatherSelectablesInFrustum(
+	const FRTSSelectionFrustum& Frustum,
+	TArray<int32>& OutSlots
+) const
+{
+	if (this->Selectables.IsEmpty())
+	{
+		return;
+	}
+
+	// Clip the frustum against the horizontal slab that contains every selectable, padded by the largest unit.
+	const auto SlabBottom = this->MinimumZ - this->MaximumBoundsRadius;
+	const auto SlabTop = this->MaximumZ + this->MaximumBoundsRadius;
+
+	FBox2D Footprint(ForceInit);
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		const auto& Origin = Frustum.CornerOrigins[Index];
+		const auto& Direction = Frustum.CornerDirections[Index];
+
+		// A corner ray that never leaves the slab means the footprint is unbounded (looking at the horizon).
+		if (FMath::IsNearlyZero(Direction.Z))
+		{
+			if (Origin.Z >= SlabBottom && Origin.Z <= SlabTop)
+			{
+				this->GatherAllSelectables(OutSlots);
+				return;
+			}
+			continue;
+		}
+
+		const auto EnterTime = (SlabTop - Origin.Z) / Direction.Z;
+		const auto ExitTime = (SlabBottom - Origin.Z) / Direction.Z;
+		const auto NearTime = FMath::Max(FMath::Min(EnterTime, ExitTime), 0.0);
+		const auto FarTime = FMath::Max(EnterTime, ExitTime);
+		if (FarTime < 0.0)
+		{
+			continue;
+		}
+
+		const auto Near = Origin + Direction * NearTime;
+		const auto Far = Origin + Direction * FarTime;
+		Footprint += FVector2D(Near.X, Near.Y);
+		Footprint += FVector2D(Far.X, Far.Y);
+	}
+
+	if (Footprint.bIsValid)
+	{
+		this->GatherSelectablesInFootprint(Footprint.ExpandBy(this->MaximumBoundsRadius), OutSlots);
+	}
+}
+
+void URTSSelectionSubsystem::GatherSelectablesInFootprint(const FBox2D& Footprint, TArray<int32>& OutSlots) const
+{
+	const auto MinimumCell = this->GetCell(FVector(Footprint.Min.X, Footprint.Min.Y, 0.0));
+	const auto MaximumCell = this->GetCell(FVector(Footprint.Max.X, Footprint.Max.Y, 0.0));
+	// Widened before subtracting, the clamped cell coordinates span more than an int32 can hold
+	const auto NumCellsInFootprint =
+		(static_cast<int64>(MaximumCell.X) - static_cast<int64>(MinimumCell.X) + 1)
+		* (static_cast<int64>(MaximumCell.Y) - static_cast<int64>(MinimumCell.Y) + 1);
+
+	// When the footprint covers more cells than are occupied, walking the occupied cells is cheaper.
+	if (NumCellsInFootprint > this->Cells.Num())
+	{
+		for (const auto& [Cell, CellSlots] : this->Cells)
+		{
+			if (Cell.X >= MinimumCell.X && Cell.X <= MaximumCell.X && Cell.Y >= MinimumCell.Y && Cell.Y <= MaximumCell.Y)
+			{
+				OutSlots.Append(CellSlots);
+			}
+		}
+		return;
+	}
+
+	for (auto X = MinimumCell.X; X <= MaximumCell.X; ++X)
+	{
+		for (auto Y = MinimumCell.Y; Y <= MaximumCell.Y; ++Y)
+		{
+			if (const auto* CellSlots = this->Cells.Find(FIntPoint(X, Y)))
+			{
+				OutSlots.Append(*CellSlots);
+			}
+		}
+	}
+}
+
+void URTSSelectionSubsystem::FilterSlots(const FRTSSelectionFilter& Filter, TArray<int32>& InOutSlots) const
+{
+	auto NumPassed = 0;
+	for (const auto Slot : InOutSlots)
+	{
+		// Branch-free compaction, every slot is written and the cursor only advances past the ones that pass
+		InOutSlots[NumPassed] = Slot;
+		NumPassed += Filter.Passes(this->FilterBits[this->SlotToDense[Slot]]) ? 1 : 0;
+	}
+
+	InOutSlots.SetNum(NumPassed, false);
+}
+
+int32 URTSSelectionSubsystem::PickSelectable(
+	const FVector& RayOrigin,
+	const FVector& RayDirection,
+	const float ToleranceRadius,
+	const float ToleranceSlope
+) const
+{
+	if (this->Selectables.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	const auto Direction = RayDirection.GetSafeNormal();
+	const auto Padding = this->MaximumBoundsRadius + ToleranceRadius;
+
+	// A selectable can only be hit at a ray time t where the ray passes within Padding + ToleranceSlope * t of the
+	// slab of selectables, so solve MinimumZ - Padding - s * t <= Z(t) <= MaximumZ + Padding + s * t for t >= 0. Each
+	// side is a linear constraint k * t >= c that bounds t from below or above.
+	auto NearTime = 0.0;
+	auto FarTime = TNumericLimits<double>::Max();
+	const auto Constrain = [&NearTime, &FarTime](const double K, const double C)
+	{
+		if (FMath::IsNearlyZero(K))
+		{
+			if (C > 0.0)
+			{
+				FarTime = -1.0;
+			}
+		}
+		else if (K > 0.0)
+		{
+			NearTime = FMath::Max(NearTime, C / K);
+		}
+		else
+		{
+			FarTime = FMath::Min(FarTime, C / K);
+		}
+	};
+	Constrain(Direction.Z + ToleranceSlope, this->MinimumZ - Padding - RayOrigin.Z);
+	Constrain(ToleranceSlope - Direction.Z, RayOrigin.Z - this->MaximumZ - Padding);
+	if (NearTime > FarTime)
+	{
+		return INDEX_NONE;
+	}
+
+	// Only the grid cells under that part of the ray can be hit. A ray that stays near the slab forever, e.g. one
+	// parallel to the ground or one whose tolerance cone widens faster than it climbs, may hit anything.
+	this->ScratchSlots.Reset();
+	if (FarTime == TNumericLimits<double>::Max())
+	{
+		this->GatherAllSelectables(this->ScratchSlots);
+	}
+	else
+	{
+		const auto Near = RayOrigin + Direction * NearTime;
+		const auto Far = RayOrigin + Direction * FarTime;
+		FBox2D Footprint(ForceInit);
+		Footprint += FVector2D(Near.X, Near.Y);
+		Footprint += FVector2D(Far.X, Far.Y);
+		this->GatherSelectablesInFootprint(
+			Footprint.ExpandBy(Padding + ToleranceSlope * FarTime),
+			this->ScratchSlots
+		);
+	}
+
+	auto ClosestSlot = INDEX_NONE;
+	auto ClosestHitTime = TNumericLimits<double>::Max();
+	for (const auto Slot : this->ScratchSlots)
+	{
+		const auto DenseIndex = this->SlotToDense[Slot];
+		const auto ToCenter = FVector(
+			this->LocationsX[DenseIndex],
+			this->LocationsY[DenseIndex],
+			this->LocationsZ[DenseIndex]
+		) - RayOrigin;
+		const auto CenterTime = ToCenter | Direction;
+		if (CenterTime < 0.0)
+		{
+			continue;
+		}
+
+		const auto Radius = this->BoundsRadii[DenseIndex] + ToleranceRadius + ToleranceSlope * CenterTime;
+		const auto DistanceSquared = ToCenter.SizeSquared() - FMath::Square(CenterTime);
+		if (DistanceSquared > FMath::Square(Radius))
+		{
+			continue;
+		}
+
+		const auto HitTime = CenterTime - FMath::Sqrt(FMath::Square(Radius) - DistanceSquared);
+		if (HitTime < ClosestHitTime)
+		{
+			ClosestHitTime = HitTime;
+			ClosestSlot = Slot;
+		}
+	}
+
+	return ClosestSlot;
+}
+
+int32 URTSSelectionSubsystem::FindSlotByOwner(const AActor* Owner) const
+{
+	const auto* Slot = this->OwnerToSlot.Find(Owner);
+	return Slot != nullptr ? *Slot : INDEX_NONE;
+}
+
+bool URTSSelectionSubsystem::IsValidSlot(const int32 Slot) const
+{
+	return this->SlotToDense.IsValidIndex(Slot) && this->SlotToDense[Slot] != INDEX_NONE;
+}
+
+FRTSSelectableHandle URTSSelectionSubsystem::GetHandle(const int32 Slot) const
+{
+	return this->IsValidSlot(Slot) ? FRTSSelectableHandle(Slot, this->SlotGenerations[Slot]) : FRTSSelectableHandle();
+}
+
+int32 URTSSelectionSubsystem::ResolveHandle(const FRTSSelectableHandle Handle) const
+{
+	const auto Slot = Handle.GetSlot();
+	return this->IsValidSlot(Slot) && this->SlotGenerations[Slot] == Handle.GetGeneration() ? Slot : INDEX_NONE;
+}
+
+URTSSelectable* URTSSelectionSubsystem::GetSelectable(const FRTSSelectableHandle Handle) const
+{
+	const auto Slot = this->ResolveHandle(Handle);
+	return Slot != INDEX_NONE ? this->Selectables[this->SlotToDense[Slot]] : nullptr;
+}
+
+uint32 URTSSelectionSubsystem::GetNumRemovals() const
+{
+	return this->NumRemovals;
+}
+
+int32 URTSSelectionSubsystem::GetDenseIndex(const int32 Slot) const
+{
+	return this->IsValidSlot(Slot) ? this->SlotToDense[Slot] : INDEX_NONE;
+}
+
+int32 URTSSelectionSubsystem::GetSlot(const int32 DenseIndex) const
+{
+	return this->DenseToSlot[DenseIndex];
+}
+
+int32 URTSSelectionSubsystem::GetSlotCapacity() const
+{
+	return this->SlotToDense.Num();
+}
+
+int32 URTSSelectionSubsystem::GetNumSelectables() const
+{
+	return this->Selectables.Num();
+}
+
+URTSSelectable* URTSSelectionSubsystem::GetSelectable(const int32 Slot) const
+{
+	return this->IsValidSlot(Slot) ? this->Selectables[this->SlotToDense[Slot]] : nullptr;
+}
+
+AActor* URTSSelectionSubsystem::GetOwner(const int32 Slot) const
+{
+	return this->IsValidSlot(Slot) ? this->Owners[this->SlotToDense[Slot]] : nullptr;
+}
+
+FVector URTSSelectionSubsystem::GetLocation(const int32 Slot) const
+{
+	const auto DenseIndex = this->SlotToDense[Slot];
+	return FVector(this->LocationsX[DenseIndex], this->LocationsY[DenseIndex], this->LocationsZ[DenseIndex]);
+}
+
+float URTSSelectionSubsystem::GetBoundsRadius(const int32 Slot) const
+{
+	return this->BoundsRadii[this->SlotToDense[Slot]];
+}
+
+uint64 URTSSelectionSubsystem::GetFilterBits(const int32 Slot) const
+{
+	return this->FilterBits[this->SlotToDense[Slot]];
+}
+
+TConstArrayView<URTSSelectable*> URTSSelectionSubsystem::GetSelectables() const
+{
+	return this->Selectables;
+}
+
+TConstArrayView<AActor*> URTSSelectionSubsystem::GetOwners() const
+{
+	return this->Owners;
+}
+
+TConstArrayView<float> URTSSelectionSubsystem::GetLocationsX() const
+{
+	return this->LocationsX;
+}
+
+TConstArrayView<float> URTSSelectionSubsystem::GetLocationsY() const
+{
+	return this->LocationsY;
+}
+
+TConstArrayView<float> URTSSelectionSubsystem::GetLocationsZ() const
+{
+	return this->LocationsZ;
+}
+
+TConstArrayView<float> URTSSelectionSubsystem::GetBoundsRadii() const
+{
+	return this->BoundsRadii;
+}
+
+FIntPoint URTSSelectionSubsystem::GetCell(const FVector& Location) const
+{
+	// Clamped so that footprints reaching towards the horizon cannot overflow the cell coordinates.
+	constexpr double MaximumCellCoordinate = 1 << 30;
+	return FIntPoint(
+		FMath::FloorToInt32(FMath::Clamp(Location.X / this->GridCellSize, -MaximumCellCoordinate, MaximumCellCoordinate)),
+		FMath::FloorToInt32(FMath::Clamp(Location.Y / this->GridCellSize, -MaximumCellCoordinate, MaximumCellCoordinate))
+	);
+}
+
+void URTSSelectionSubsystem::AddToCell(const FIntPoint& Cell, const int32 Slot)
+{
+	this->Cells.FindOrAdd(Cell).Add(Slot);
+}
+
+void URTSSelectionSubsystem::RemoveFromCell(const FIntPoint& Cell, const int32 Slot)
+{
+	if (auto* CellSlots = this->Cells.Find(Cell))
+	{
+		CellSlots->RemoveSingleSwap(Slot, false);
+		if (CellSlots->IsEmpty())
+		{
+			this->Cells.Remove(Cell);
+		}
+	}
+}
+
+void URTSSelectionSubsystem::GatherAllSelectables(TArray<int32>& OutSlots) const
+{
+	OutSlots.Append(this->DenseToSlot);
+}
+
+void URTSSelectionSubsystem::CullCandidateSlots(
+	const FRTSSelectionFrustum& Frustum,
+	const TConstArrayView<int32> CandidateSlots,
+	TArray<int32>& OutSlots
+) const
+{
+	const auto NumCandidates = CandidateSlots.Num();
+	this->ScratchX.SetNumUninitialized(NumCandidates, false);
+	this->ScratchY.SetNumUninitialized(NumCandidates, false);
+	this->ScratchZ.SetNumUninitialized(NumCandidates, false);
+	this->ScratchRadii.SetNumUninitialized(NumCandidates, false);
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		const auto DenseIndex = this->SlotToDense[CandidateSlots[Index]];
+		this->ScratchX[Index] = this->LocationsX[DenseIndex];
+		this->ScratchY[Index] = this->LocationsY[DenseIndex];
+		this->ScratchZ[Index] = this->LocationsZ[DenseIndex];
+		this->ScratchRadii[Index] = this->BoundsRadii[DenseIndex];
+	}
+
+	this->ScratchIndices.Reset();
+	Frustum.CullSpheres(
+		this->ScratchX.GetData(),
+		this->ScratchY.GetData(),
+		this->ScratchZ.GetData(),
+		this->ScratchRadii.GetData(),
+		NumCandidates,
+		this->ScratchIndices
+	);
+
+	OutSlots.Reserve(OutSlots.Num() + this->ScratchIndices.Num());
+	for (const auto CandidateIndex : this->ScratchIndices)
+	{
+		OutSlots.Add(CandidateSlots[CandidateIndex]);
+	}
+}
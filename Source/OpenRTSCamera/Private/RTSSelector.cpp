@@ -4,15 +4,42 @@
 
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "RTSActorGroup.h"
+#include "RTSCamera.h"
+#include "RTSCameraStats.h"
 #include "RTSSelectable.h"
+#include "RTSSelectionIndicatorComponent.h"
+#include "RTSSelectionSubsystem.h"
+#include "RTSViewportSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/StaticMesh.h"
 #include "Kismet/GameplayStatics.h"
+#include "Materials/MaterialInterface.h"
 
 // Sets default values for this component's properties
-URTSSelector::URTSSelector(): PlayerController(nullptr), HUD(nullptr), bIsSelecting(false)
+URTSSelector::URTSSelector(): PlayerController(nullptr), HUD(nullptr), SelectionGroup(nullptr),
+                               SelectionIndicators(nullptr), bIsSelecting(false)
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
+	this->EnableSelectionPreview = false;
+	this->CallCanSelectActor = false;
+	this->CallHandleSelectedActors = false;
+	this->EnableSelectableEvents = true;
+	this->MaxSelectionNotificationsPerFrame = 0;
+	this->NextPendingNotification = 0;
+	this->IsDeliveringNotifications = false;
+	this->EnableSelectionIndicators = false;
+	this->ClickDistanceThreshold = 4.0f;
+	this->PointPickTolerance = 6.0f;
+	this->ControlGroupDoubleTapTime = 0.3f;
+	this->ControlGroups.Init(nullptr, NumControlGroups);
+	this->LastRecalledControlGroup = INDEX_NONE;
+	this->LastControlGroupRecallTime = 0.0;
+	this->PreviewRectangle = FBox2D(ForceInit);
+	this->PreviewViewportSize = FVector2D::ZeroVector;
+
+	// Selection is driven by input events, the tick only drains notifications held back by the per-frame budget
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	// Add defaults for input actions
 	static ConstructorHelpers::FObjectFinder<UInputAction>
@@ -21,6 +48,13 @@ URTSSelector::URTSSelector(): PlayerController(nullptr), HUD(nullptr), bIsSelect
 		InputMappingContextFinder(TEXT("/OpenRTSCamera/Inputs/OpenRTSCameraInputs"));
 	this->BeginSelection = BeginSelectionActionFinder.Object;
 	this->InputMappingContext = InputMappingContextFinder.Object;
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh>
+		SelectionIndicatorMeshFinder(TEXT("/Engine/BasicShapes/Plane"));
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface>
+		SelectionIndicatorMaterialFinder(TEXT("/OpenRTSCamera/M_UnitSelection"));
+	this->SelectionIndicatorMesh = SelectionIndicatorMeshFinder.Object;
+	this->SelectionIndicatorMaterial = SelectionIndicatorMaterialFinder.Object;
 }
 
 
@@ -36,55 +70,533 @@ void URTSSelector::BeginPlay()
 		this->BindInputMappingContext();
 		this->BindInputActions();
 		OnActorsSelected.AddDynamic(this, &URTSSelector::HandleSelectedActors);
+
+		if (this->EnableSelectionIndicators)
+		{
+			this->CreateSelectionIndicators();
+		}
+	}
+
+	// Calling into the Blueprint VM per actor is expensive, so skip the hook entirely when nothing overrides it
+	this->CallCanSelectActor |= this->GetClass()->IsFunctionImplementedInScript(
+		GET_FUNCTION_NAME_CHECKED(URTSSelector, CanSelectActor)
+	);
+	this->CallHandleSelectedActors |= this->GetClass()->IsFunctionImplementedInScript(
+		GET_FUNCTION_NAME_CHECKED(URTSSelector, HandleSelectedActors)
+	);
+}
+
+void URTSSelector::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (this->SelectionIndicators != nullptr)
+	{
+		this->RemoveSelectionListener(this->SelectionIndicators);
+		this->SelectionIndicators->GetOwner()->Destroy();
+		this->SelectionIndicators = nullptr;
 	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void URTSSelector::RegisterComponentTickFunctions(const bool bRegister)
+{
+	// Nothing is ever selected on a dedicated server, so there are no notifications to spread over frames
+	if (bRegister && this->IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	Super::RegisterComponentTickFunctions(bRegister);
+}
+
+void URTSSelector::TickComponent(
+	const float DeltaTime,
+	const ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction
+)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	this->DeliverSelectionNotifications();
+}
+
+void URTSSelector::AddSelectionListener(IRTSSelectionListener* Listener)
+{
+	this->SelectionListeners.RemoveAllSwap([](const TWeakInterfacePtr<IRTSSelectionListener>& Existing)
+	{
+		return !Existing.IsValid();
+	});
+	this->SelectionListeners.AddUnique(TWeakInterfacePtr<IRTSSelectionListener>(Listener));
+}
+
+void URTSSelector::RemoveSelectionListener(IRTSSelectionListener* Listener)
+{
+	this->SelectionListeners.Remove(TWeakInterfacePtr<IRTSSelectionListener>(Listener));
 }
 
 void URTSSelector::HandleSelectedActors_Implementation(const TArray<AActor*>& NewSelectedActors)
 {
-	// Convert NewSelectedActors to a set for efficient lookup
-	TSet<AActor*> FilteredSelectedActors;
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+
+	// Resolve the new selection to registry slots
+	this->NewSelectedSlots.Reset();
 	for (const auto& Actor : NewSelectedActors)
 	{
-		if (Actor && this->CanSelectActor(Actor))
+		const auto Slot = Actor ? Registry->FindSlotByOwner(Actor) : INDEX_NONE;
+		if (Slot != INDEX_NONE)
 		{
-			FilteredSelectedActors.Add(Actor);
+			this->NewSelectedSlots.Add(Slot);
 		}
 	}
 
-	// Iterate over currently selected actors
-	for (const auto& Selected : this->SelectedActors)
+	this->SelectNewSelectedSlots(Registry);
+}
+
+void URTSSelector::SelectInScreenRectangle(const FVector2D Start, const FVector2D End)
+{
+	FRTSSelectionFrustum Frustum;
+	if (this->MakeSelectionFrustum(FRTSSelectionFrustum::MakeScreenRectangle(Start, End), Frustum))
+	{
+		this->SelectInFrustum(Frustum);
+	}
+}
+
+void URTSSelector::SelectInFrustum(const FRTSSelectionFrustum& Frustum)
+{
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	this->NewSelectedSlots.Reset();
 	{
-		// Check if the actor is not in the new selection
-		if (!FilteredSelectedActors.Contains(Selected->GetOwner()))
+		SCOPE_CYCLE_COUNTER(STAT_RTSSelectionQuery);
+		TRACE_CPUPROFILER_EVENT_SCOPE(URTSSelector::SelectInFrustum);
+		Registry->QuerySelectablesInFrustum(Frustum, this->NewSelectedSlots);
+	}
+
+	this->HandleNewSelectedSlots(Registry);
+}
+
+URTSSelectable* URTSSelector::PickSelectableAt(const FVector2D ScreenPosition) const
+{
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	return Registry->GetSelectable(this->PickSlotAt(Registry, ScreenPosition));
+}
+
+int32 URTSSelector::PickSlotAt(const URTSSelectionSubsystem* Registry, const FVector2D& ScreenPosition) const
+{
+	if (this->PlayerController == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RTSSelectionQuery);
+
+	// Deproject a second point one tolerance to the side to turn the pixel tolerance into world units
+	const auto& Snapshot = this->GetWorld()->GetSubsystem<URTSViewportSubsystem>()->GetViewportSnapshot();
+	const auto TolerancePixels = this->PointPickTolerance * Snapshot.DPIScale;
+	FVector Origin, Direction, ToleranceOrigin, ToleranceDirection;
+	if (!this->PlayerController->DeprojectScreenPositionToWorld(ScreenPosition.X, ScreenPosition.Y, Origin, Direction)
+		|| !this->PlayerController->DeprojectScreenPositionToWorld(
+			ScreenPosition.X + TolerancePixels,
+			ScreenPosition.Y,
+			ToleranceOrigin,
+			ToleranceDirection
+		))
+	{
+		return INDEX_NONE;
+	}
+
+	// Orthographic views shift the origin, perspective views rotate the direction
+	const auto ToleranceRadius = FVector::Dist(Origin, ToleranceOrigin);
+	const auto ToleranceSlope = FMath::Tan(FMath::Acos(FMath::Clamp(Direction | ToleranceDirection, -1.0, 1.0)));
+	return Registry->PickSelectable(
+		Origin,
+		Direction,
+		static_cast<float>(ToleranceRadius),
+		static_cast<float>(ToleranceSlope)
+	);
+}
+
+void URTSSelector::SelectAllOfTypeOnScreen(const AActor* Actor)
+{
+	if (Actor == nullptr || this->PlayerController == nullptr)
+	{
+		return;
+	}
+
+	const auto& Snapshot = this->GetWorld()->GetSubsystem<URTSViewportSubsystem>()->GetViewportSnapshot();
+	FRTSSelectionFrustum Frustum;
+	if (Snapshot.ViewportSize.X <= 0.0
+		|| Snapshot.ViewportSize.Y <= 0.0
+		|| !this->MakeSelectionFrustum(FBox2D(FVector2D::ZeroVector, Snapshot.ViewportSize), Frustum))
+	{
+		return;
+	}
+
+	// Only the selectables of this class are tested, however many others there are on screen
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	this->NewSelectedSlots.Reset();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RTSSelectionQuery);
+		Registry->QuerySelectablesOfClassInFrustum(Actor->GetClass(), Frustum, this->NewSelectedSlots);
+	}
+
+	this->HandleNewSelectedSlots(Registry);
+}
+
+void URTSSelector::HandleNewSelectedSlots(const URTSSelectionSubsystem* Registry)
+{
+	if (!this->CallHandleSelectedActors)
+	{
+		this->SelectNewSelectedSlots(Registry);
+		return;
+	}
+
+	// A Blueprint override gets the final word, it receives the actors and resolves them back to slots itself
+	TArray<AActor*> Actors;
+	Actors.Reserve(this->NewSelectedSlots.Num());
+	for (const auto Slot : this->NewSelectedSlots)
+	{
+		Actors.Add(Registry->GetOwner(Slot));
+	}
+	this->HandleSelectedActors(Actors);
+}
+
+void URTSSelector::SelectNewSelectedSlots(const URTSSelectionSubsystem* Registry)
+{
+	this->GrowSlotBits(Registry->GetSlotCapacity());
+
+	// Filter natively before any Blueprint is involved
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RTSSelectionFilter);
+		Registry->FilterSlots(this->SelectionFilter, this->NewSelectedSlots);
+
+		// Drop duplicates and give CanSelectActor a final say over the survivors
+		auto NumSelected = 0;
+		for (const auto Slot : this->NewSelectedSlots)
 		{
-			// Call OnDeselected for actors that are no longer selected
-			Selected->OnDeselected();
+			if (!this->NewSelectedSlotBits[Slot]
+				&& (!this->CallCanSelectActor || this->CanSelectActor(Registry->GetOwner(Slot))))
+			{
+				this->NewSelectedSlotBits[Slot] = true;
+				this->NewSelectedSlots[NumSelected++] = Slot;
+			}
 		}
+		this->NewSelectedSlots.SetNum(NumSelected, false);
 	}
 
-	// Clear the current selection
-	ClearSelectedActors();
-    
-	// Add new selected actors and call OnSelected
-	for (const auto& Actor : NewSelectedActors)
+	this->ApplySelectionDelta(Registry);
+
+	SET_DWORD_STAT(STAT_RTSSelectedActors, this->Selection.Num());
+	CSV_CUSTOM_STAT(OpenRTSCamera, SelectedActors, this->Selection.Num(), ECsvCustomStatOp::Set);
+}
+
+void URTSSelector::ClearSelectedActors_Implementation()
+{
+	// An empty selection, so that everything selected gets its deselection notification
+	this->NewSelectedSlots.Reset();
+	this->ApplySelectionDelta(this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>());
+
+	SET_DWORD_STAT(STAT_RTSSelectedActors, 0);
+	CSV_CUSTOM_STAT(OpenRTSCamera, SelectedActors, 0, ECsvCustomStatOp::Set);
+}
+
+URTSSelectionIndicatorComponent* URTSSelector::GetSelectionIndicators() const
+{
+	return this->SelectionIndicators;
+}
+
+TArray<URTSSelectable*> URTSSelector::GetSelectedActors() const
+{
+	TArray<URTSSelectable*> SelectedActors;
+	SelectedActors.Reserve(this->Selection.Num());
+
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	this->Selection.ForEach(*Registry, [&SelectedActors, Registry](FRTSSelectableHandle, const int32 Slot)
+	{
+		SelectedActors.Add(Registry->GetSelectable(Slot));
+	});
+
+	return SelectedActors;
+}
+
+const FRTSSelectionSet& URTSSelector::GetSelection() const
+{
+	return this->Selection;
+}
+
+void URTSSelector::AssignControlGroup(const int32 Index)
+{
+	if (!this->ControlGroups.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	this->ControlGroupSelections[Index].Reset();
+	if (this->ControlGroups[Index] != nullptr)
+	{
+		this->ControlGroups[Index]->Reset();
+	}
+
+	this->AddToControlGroup(Index);
+}
+
+void URTSSelector::AddToControlGroup(const int32 Index)
+{
+	if (!this->ControlGroups.IsValidIndex(Index))
 	{
-		if (URTSSelectable* SelectableComponent = Actor->FindComponentByClass<URTSSelectable>())
+		return;
+	}
+
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	const auto Group = this->GetControlGroup(Index);
+	auto& GroupSelection = this->ControlGroupSelections[Index];
+	this->Selection.ForEach(
+		*Registry,
+		[Registry, Group, &GroupSelection](const FRTSSelectableHandle Handle, const int32 Slot)
 		{
-			this->SelectedActors.Add(SelectableComponent);
-			SelectableComponent->OnSelected();
+			if (GroupSelection.Add(*Registry, Handle))
+			{
+				Group->AddActor(Registry->GetOwner(Slot));
+			}
 		}
+	);
+}
+
+void URTSSelector::RecallControlGroup(const int32 Index)
+{
+	if (!this->ControlGroups.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	const auto Now = this->GetWorld()->GetRealTimeSeconds();
+	const auto IsDoubleTap = Index == this->LastRecalledControlGroup
+		&& Now - this->LastControlGroupRecallTime <= this->ControlGroupDoubleTapTime;
+	this->LastRecalledControlGroup = Index;
+	this->LastControlGroupRecallTime = Now;
+
+	// Members may have become unselectable since the group was assigned, so they go through the same filters and
+	// hooks as any other selection
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	this->NewSelectedSlots.Reset();
+	this->ControlGroupSelections[Index].ForEach(*Registry, [this](FRTSSelectableHandle, const int32 Slot)
+	{
+		this->NewSelectedSlots.Add(Slot);
+	});
+	this->HandleNewSelectedSlots(Registry);
+
+	if (IsDoubleTap)
+	{
+		this->JumpToControlGroup(Index);
 	}
 }
 
-void URTSSelector::ClearSelectedActors_Implementation()
+void URTSSelector::JumpToControlGroup(const int32 Index)
 {
-	this->SelectedActors.Empty();
+	const auto Group = this->ControlGroups.IsValidIndex(Index) ? this->ControlGroups[Index] : nullptr;
+	if (Group == nullptr || Group->Num() == 0 || this->PlayerController == nullptr)
+	{
+		return;
+	}
+
+	const auto ViewTarget = this->PlayerController->GetViewTarget();
+	if (const auto Camera = ViewTarget != nullptr ? ViewTarget->FindComponentByClass<URTSCamera>() : nullptr)
+	{
+		// The camera keeps its own height, the ground stage settles it over the new location
+		const auto Centroid = Group->GetCentroid();
+		Camera->JumpTo(FVector(Centroid.X, Centroid.Y, ViewTarget->GetActorLocation().Z));
+	}
 }
 
-// Called every frame
-void URTSSelector::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+URTSActorGroup* URTSSelector::GetControlGroup(const int32 Index)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (!this->ControlGroups.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+
+	if (this->ControlGroups[Index] == nullptr)
+	{
+		this->ControlGroups[Index] = NewObject<URTSActorGroup>(this);
+	}
+
+	return this->ControlGroups[Index];
+}
+
+const FRTSSelectionSet& URTSSelector::GetControlGroupSelection(const int32 Index) const
+{
+	check(this->ControlGroups.IsValidIndex(Index));
+	return this->ControlGroupSelections[Index];
+}
+
+URTSActorGroup* URTSSelector::GetSelectionGroup()
+{
+	if (this->SelectionGroup == nullptr)
+	{
+		this->SelectionGroup = NewObject<URTSActorGroup>(this);
+		const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+		this->Selection.ForEach(*Registry, [this, Registry](FRTSSelectableHandle, const int32 Slot)
+		{
+			this->SelectionGroup->AddActor(Registry->GetOwner(Slot));
+		});
+	}
+
+	return this->SelectionGroup;
+}
+
+void URTSSelector::ApplySelectionDelta(const URTSSelectionSubsystem* Registry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(URTSSelector::ApplySelectionDelta);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RTSSelectionDiff);
+
+		// Selectables that have unregistered since simply drop out, they have nobody left to notify
+		this->Selection.Prune(*Registry);
+
+		// Deselect everything that is not part of the new selection
+		for (const auto Handle : this->Selection.GetHandles())
+		{
+			const auto Slot = Handle.GetSlot();
+			if (this->Selection.IsMember(Handle) && !this->NewSelectedSlotBits[Slot])
+			{
+				const auto Selectable = Registry->GetSelectable(Slot);
+				this->Selection.Remove(Handle);
+				this->PendingNotifications.Add(Selectable);
+				this->PendingNotificationIsSelected.Add(false);
+				if (this->SelectionGroup != nullptr)
+				{
+					this->SelectionGroup->RemoveActor(Selectable->GetOwner());
+				}
+			}
+		}
+
+		// Select what is new, unchanged selectables do not get another event
+		for (const auto Slot : this->NewSelectedSlots)
+		{
+			this->NewSelectedSlotBits[Slot] = false;
+			if (this->Selection.Add(*Registry, Registry->GetHandle(Slot)))
+			{
+				const auto Selectable = Registry->GetSelectable(Slot);
+				this->PendingNotifications.Add(Selectable);
+				this->PendingNotificationIsSelected.Add(true);
+				if (this->SelectionGroup != nullptr)
+				{
+					this->SelectionGroup->AddActor(Selectable->GetOwner());
+				}
+			}
+		}
+	}
+
+	this->DeliverSelectionNotifications();
+}
+
+void URTSSelector::DeliverSelectionNotifications()
+{
+	// Listeners and selectables may change the selection from their callbacks. Their notifications are queued behind
+	// the ones being delivered and picked up by the loop below, in order, instead of being delivered in between.
+	if (this->IsDeliveringNotifications)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RTSSelectionNotify);
+	TGuardValue<bool> DeliveringGuard(this->IsDeliveringNotifications, true);
+
+	auto Budget = this->MaxSelectionNotificationsPerFrame > 0 ? this->MaxSelectionNotificationsPerFrame : MAX_int32;
+	while (Budget > 0 && this->NextPendingNotification < this->PendingNotifications.Num())
+	{
+		const auto Start = this->NextPendingNotification;
+		const auto NumToDeliver = FMath::Min(this->PendingNotifications.Num() - Start, Budget);
+		Budget -= NumToDeliver;
+
+		// Take the batch off the queue before dispatching, so that callbacks appending to the queue cannot move the
+		// storage out from under the spans handed to the listeners
+		this->DeliveringNotifications.Reset();
+		this->DeliveringNotifications.Append(&this->PendingNotifications[Start], NumToDeliver);
+		this->DeliveringNotificationIsSelected.Init(false, NumToDeliver);
+		for (int32 Index = 0; Index < NumToDeliver; ++Index)
+		{
+			this->DeliveringNotificationIsSelected[Index] = this->PendingNotificationIsSelected[Start + Index];
+		}
+
+		if (Start + NumToDeliver == this->PendingNotifications.Num())
+		{
+			this->PendingNotifications.Reset();
+			this->PendingNotificationIsSelected.Reset();
+			this->NextPendingNotification = 0;
+		}
+		else
+		{
+			this->NextPendingNotification = Start + NumToDeliver;
+		}
+
+		// Hand out each run of selections or deselections as one span
+		auto RunStart = 0;
+		while (RunStart < NumToDeliver)
+		{
+			const bool IsSelected = this->DeliveringNotificationIsSelected[RunStart];
+			auto RunEnd = RunStart + 1;
+			while (RunEnd < NumToDeliver && this->DeliveringNotificationIsSelected[RunEnd] == IsSelected)
+			{
+				++RunEnd;
+			}
+
+			this->NotifySelectionChanged(
+				TConstArrayView<URTSSelectable*>(this->DeliveringNotifications).Slice(RunStart, RunEnd - RunStart),
+				IsSelected
+			);
+			RunStart = RunEnd;
+		}
+	}
+
+	this->DeliveringNotifications.Reset();
+	this->SetComponentTickEnabled(this->NextPendingNotification < this->PendingNotifications.Num());
+}
+
+void URTSSelector::NotifySelectionChanged(const TConstArrayView<URTSSelectable*> Selectables, const bool IsSelected)
+{
+	for (const auto& Listener : this->SelectionListeners)
+	{
+		if (const auto ListenerInterface = Listener.Get())
+		{
+			if (IsSelected)
+			{
+				ListenerInterface->OnSelectablesSelected(Selectables);
+			}
+			else
+			{
+				ListenerInterface->OnSelectablesDeselected(Selectables);
+			}
+		}
+	}
+
+	if (!this->EnableSelectableEvents)
+	{
+		return;
+	}
+
+	for (const auto Selectable : Selectables)
+	{
+		if (IsValid(Selectable))
+		{
+			if (IsSelected)
+			{
+				Selectable->OnSelected();
+			}
+			else
+			{
+				Selectable->OnDeselected();
+			}
+		}
+	}
+}
+
+void URTSSelector::GrowSlotBits(const int32 SlotCapacity)
+{
+	if (this->NewSelectedSlotBits.Num() < SlotCapacity)
+	{
+		this->NewSelectedSlotBits.Add(false, SlotCapacity - this->NewSelectedSlotBits.Num());
+		this->PreviewSlotBits.Add(false, SlotCapacity - this->PreviewSlotBits.Num());
+	}
 }
 
 void URTSSelector::CollectComponentDependencyReferences()
@@ -100,6 +612,31 @@ void URTSSelector::CollectComponentDependencyReferences()
 	}
 }
 
+void URTSSelector::CreateSelectionIndicators()
+{
+	// Controllers are hidden, so the indicators get an actor of their own that sits at the origin
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = this->GetOwner();
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	const auto IndicatorActor = this->GetWorld()->SpawnActor<AActor>(
+		AActor::StaticClass(),
+		FTransform::Identity,
+		SpawnParameters
+	);
+	if (IndicatorActor == nullptr)
+	{
+		return;
+	}
+
+	this->SelectionIndicators = NewObject<URTSSelectionIndicatorComponent>(IndicatorActor);
+	this->SelectionIndicators->SetStaticMesh(this->SelectionIndicatorMesh);
+	this->SelectionIndicators->SetMaterial(0, this->SelectionIndicatorMaterial);
+	IndicatorActor->SetRootComponent(this->SelectionIndicators);
+	this->SelectionIndicators->RegisterComponent();
+
+	this->AddSelectionListener(this->SelectionIndicators);
+}
+
 void URTSSelector::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	if (const auto InputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent))
@@ -156,23 +693,317 @@ void URTSSelector::BindInputMappingContext()
 
 void URTSSelector::OnSelectionStart(const FInputActionValue& Value)
 {
-	FVector2D MousePosition;
-	PlayerController->GetMousePosition(MousePosition.X, MousePosition.Y);
-	HUD->BeginSelection(MousePosition);
+	const auto MousePosition = this->GetCursorPosition();
+	SelectionStart = MousePosition;
+	if (HUD)
+	{
+		HUD->BeginSelection(MousePosition);
+	}
+	this->ClearSelectionPreview();
 }
 
 void URTSSelector::OnUpdateSelection(const FInputActionValue& Value)
 {
-	FVector2D MousePosition;
-	PlayerController->GetMousePosition(MousePosition.X, MousePosition.Y);
-	SelectionEnd = MousePosition;
-	HUD->UpdateSelection(SelectionEnd);
+	SelectionEnd = this->GetCursorPosition();
+	if (HUD)
+	{
+		HUD->UpdateSelection(SelectionEnd);
+	}
+
+	if (this->EnableSelectionPreview)
+	{
+		this->UpdateSelectionPreview(FRTSSelectionFrustum::MakeScreenRectangle(SelectionStart, SelectionEnd));
+	}
 }
 
 void URTSSelector::OnSelectionEnd(const FInputActionValue& Value)
 {
-	// Call PerformSelection on the HUD to execute selection logic
-	HUD->EndSelection();
+	SelectionEnd = this->GetCursorPosition();
+	this->ClearSelectionPreview();
+	if (HUD)
+	{
+		HUD->UpdateSelection(SelectionEnd);
+		HUD->EndSelection();
+	}
+
+	// A click selects what is under the cursor, a box query would be empty for a unit smaller than the drag
+	const auto DPIScale = this->GetWorld()->GetSubsystem<URTSViewportSubsystem>()->GetViewportSnapshot().DPIScale;
+	if (FVector2D::Distance(SelectionStart, SelectionEnd) <= this->ClickDistanceThreshold * DPIScale)
+	{
+		const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+		this->NewSelectedSlots.Reset();
+		const auto Slot = this->PickSlotAt(Registry, SelectionEnd);
+		if (Slot != INDEX_NONE)
+		{
+			this->NewSelectedSlots.Add(Slot);
+		}
+		this->HandleNewSelectedSlots(Registry);
+		return;
+	}
+
+	// Resolve the box right away instead of waiting for the HUD to draw its next frame. HUDs that still customize the
+	// selection by overriding PerformSelection in Blueprint get to run it.
+	if (HUD && HUD->GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ARTSHUD, PerformSelection)))
+	{
+		HUD->PerformSelection();
+		return;
+	}
+
+	this->SelectInScreenRectangle(SelectionStart, SelectionEnd);
+}
+
+// Appends the up to four rectangles that make up Rectangle minus Subtrahend
+static void SubtractScreenRectangle(
+	const FBox2D& Rectangle,
+	const FBox2D& Subtrahend,
+	TArray<FBox2D, TInlineAllocator<4>>& OutStrips
+)
+{
+	if (!Rectangle.Intersect(Subtrahend))
+	{
+		OutStrips.Add(Rectangle);
+		return;
+	}
+
+	const auto Overlap = Rectangle.Overlap(Subtrahend);
+	if (Overlap.Min.Y > Rectangle.Min.Y)
+	{
+		OutStrips.Add(FBox2D(Rectangle.Min, FVector2D(Rectangle.Max.X, Overlap.Min.Y)));
+	}
+	if (Overlap.Max.Y < Rectangle.Max.Y)
+	{
+		OutStrips.Add(FBox2D(FVector2D(Rectangle.Min.X, Overlap.Max.Y), Rectangle.Max));
+	}
+	if (Overlap.Min.X > Rectangle.Min.X)
+	{
+		OutStrips.Add(FBox2D(FVector2D(Rectangle.Min.X, Overlap.Min.Y), FVector2D(Overlap.Min.X, Overlap.Max.Y)));
+	}
+	if (Overlap.Max.X < Rectangle.Max.X)
+	{
+		OutStrips.Add(FBox2D(FVector2D(Overlap.Max.X, Overlap.Min.Y), FVector2D(Rectangle.Max.X, Overlap.Max.Y)));
+	}
+}
+
+FVector2D URTSSelector::GetCursorPosition() const
+{
+	return this->GetWorld()->GetSubsystem<URTSViewportSubsystem>()->GetViewportSnapshot().CursorPosition;
+}
+
+bool URTSSelector::MakeSelectionFrustum(const FBox2D& Rectangle, FRTSSelectionFrustum& OutFrustum) const
+{
+	if (this->PlayerController == nullptr)
+	{
+		return false;
+	}
+
+	FVector2D Corners[4];
+	FRTSSelectionFrustum::GetScreenRectangleCorners(Rectangle, Corners);
+
+	FVector CornerOrigins[4];
+	FVector CornerDirections[4];
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		if (!this->PlayerController->DeprojectScreenPositionToWorld(
+			Corners[Index].X,
+			Corners[Index].Y,
+			CornerOrigins[Index],
+			CornerDirections[Index]
+		))
+		{
+			return false;
+		}
+	}
+
+	OutFrustum = FRTSSelectionFrustum(CornerOrigins, CornerDirections);
+	return true;
+}
+
+void URTSSelector::UpdateSelectionPreview(const FBox2D& Rectangle)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RTSSelectionQuery);
+
+	// Edge scrolling keeps moving the view while dragging, which moves the world under an unchanged box
+	FMinimalViewInfo View;
+	const auto HasView = this->GetSelectionView(View);
+	const auto& Snapshot = this->GetWorld()->GetSubsystem<URTSViewportSubsystem>()->GetViewportSnapshot();
+	const auto IsSameView = HasView
+		&& Snapshot.ViewportSize == this->PreviewViewportSize
+		&& View.ProjectionMode == this->PreviewView.ProjectionMode
+		&& View.Location.Equals(this->PreviewView.Location)
+		&& View.Rotation.Equals(this->PreviewView.Rotation)
+		&& View.FOV == this->PreviewView.FOV
+		&& View.OrthoWidth == this->PreviewView.OrthoWidth;
+
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	FRTSSelectionFrustum Frustum;
+	if (!this->MakeSelectionFrustum(Rectangle, Frustum))
+	{
+		return;
+	}
+
+	this->GrowSlotBits(Registry->GetSlotCapacity());
+	this->PreviewView = View;
+	this->PreviewViewportSize = Snapshot.ViewportSize;
+
+	if (!IsSameView)
+	{
+		this->ResolveSelectionPreview(Registry, Frustum);
+		this->PreviewRectangle = Rectangle;
+		return;
+	}
+
+	// Units keep moving under a still box, so what is previewed is re-tested against the whole box every frame
+	this->RevalidateSelectionPreview(Registry, Frustum);
+	if (Rectangle == this->PreviewRectangle)
+	{
+		return;
+	}
+
+	// Strips that entered the box: everything there touches the new box, so only the new ones need an event
+	TArray<FBox2D, TInlineAllocator<4>> Strips;
+	FRTSSelectionFrustum StripFrustum;
+	if (this->PreviewRectangle.bIsValid)
+	{
+		SubtractScreenRectangle(Rectangle, this->PreviewRectangle, Strips);
+	}
+	else
+	{
+		Strips.Add(Rectangle);
+	}
+	for (const auto& Strip : Strips)
+	{
+		this->PreviewStripSlots.Reset();
+		if (this->MakeSelectionFrustum(Strip, StripFrustum))
+		{
+			Registry->QuerySelectablesInFrustum(StripFrustum, this->PreviewStripSlots);
+			Registry->FilterSlots(this->SelectionFilter, this->PreviewStripSlots);
+		}
+
+		for (const auto Slot : this->PreviewStripSlots)
+		{
+			if (!this->PreviewSlotBits[Slot])
+			{
+				this->PreviewSlotBits[Slot] = true;
+				this->PreviewHandles.Add(Registry->GetHandle(Slot));
+				Registry->GetSelectable(Slot)->OnPreviewEnter();
+			}
+		}
+	}
+
+	this->PreviewRectangle = Rectangle;
+}
+
+void URTSSelector::RevalidateSelectionPreview(
+	const URTSSelectionSubsystem* Registry,
+	const FRTSSelectionFrustum& Frustum
+)
+{
+	auto AnyExited = false;
+	for (const auto Handle : this->PreviewHandles)
+	{
+		const auto Slot = Registry->ResolveHandle(Handle);
+		if (Slot == INDEX_NONE)
+		{
+			// Unregistered, and its slot may already belong to a selectable that still has to enter
+			this->PreviewSlotBits[Handle.GetSlot()] = false;
+			AnyExited = true;
+		}
+		else if (!Frustum.IntersectsSphere(Registry->GetLocation(Slot), Registry->GetBoundsRadius(Slot)))
+		{
+			this->PreviewSlotBits[Slot] = false;
+			Registry->GetSelectable(Slot)->OnPreviewExit();
+			AnyExited = true;
+		}
+	}
+
+	if (AnyExited)
+	{
+		this->RemoveExitedPreviewHandles();
+	}
+}
+
+void URTSSelector::ResolveSelectionPreview(
+	const URTSSelectionSubsystem* Registry,
+	const FRTSSelectionFrustum& Frustum
+)
+{
+	this->PreviewStripSlots.Reset();
+	Registry->QuerySelectablesInFrustum(Frustum, this->PreviewStripSlots);
+	Registry->FilterSlots(this->SelectionFilter, this->PreviewStripSlots);
+
+	// Mark what is under the box now in the scratch bits, the enter pass below clears every one of them again
+	for (const auto Slot : this->PreviewStripSlots)
+	{
+		this->NewSelectedSlotBits[Slot] = true;
+	}
+
+	auto AnyExited = false;
+	for (const auto Handle : this->PreviewHandles)
+	{
+		const auto Slot = Registry->ResolveHandle(Handle);
+		if (Slot == INDEX_NONE)
+		{
+			this->PreviewSlotBits[Handle.GetSlot()] = false;
+			AnyExited = true;
+		}
+		else if (!this->NewSelectedSlotBits[Slot])
+		{
+			this->PreviewSlotBits[Slot] = false;
+			Registry->GetSelectable(Slot)->OnPreviewExit();
+			AnyExited = true;
+		}
+	}
+
+	if (AnyExited)
+	{
+		this->RemoveExitedPreviewHandles();
+	}
+
+	for (const auto Slot : this->PreviewStripSlots)
+	{
+		this->NewSelectedSlotBits[Slot] = false;
+		if (!this->PreviewSlotBits[Slot])
+		{
+			this->PreviewSlotBits[Slot] = true;
+			this->PreviewHandles.Add(Registry->GetHandle(Slot));
+			Registry->GetSelectable(Slot)->OnPreviewEnter();
+		}
+	}
+}
+
+void URTSSelector::RemoveExitedPreviewHandles()
+{
+	this->PreviewHandles.RemoveAllSwap(
+		[this](const FRTSSelectableHandle Handle) { return !this->PreviewSlotBits[Handle.GetSlot()]; },
+		false
+	);
+}
+
+bool URTSSelector::GetSelectionView(FMinimalViewInfo& OutView) const
+{
+	if (this->PlayerController == nullptr || this->PlayerController->PlayerCameraManager == nullptr)
+	{
+		return false;
+	}
+
+	OutView = this->PlayerController->PlayerCameraManager->GetCameraCacheView();
+	return true;
+}
+
+void URTSSelector::ClearSelectionPreview()
+{
+	const auto Registry = this->GetWorld()->GetSubsystem<URTSSelectionSubsystem>();
+	for (const auto Handle : this->PreviewHandles)
+	{
+		this->PreviewSlotBits[Handle.GetSlot()] = false;
+		if (const auto Selectable = Registry->GetSelectable(Handle))
+		{
+			Selectable->OnPreviewExit();
+		}
+	}
+
+	this->PreviewHandles.Reset();
+	this->PreviewRectangle = FBox2D(ForceInit);
 }
 
 bool URTSSelector::CanSelectActor_Implementation(AActor *Actor) const {
@@ -0,0 +1,75 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSViewportSubsystem.h"
+
+#include "UnrealClient.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+
+void URTSViewportSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	this->ViewportResizedHandle = FViewport::ViewportResizedEvent.AddUObject(
+		this,
+		&URTSViewportSubsystem::OnViewportResized
+	);
+}
+
+void URTSViewportSubsystem::Deinitialize()
+{
+	FViewport::ViewportResizedEvent.Remove(this->ViewportResizedHandle);
+	Super::Deinitialize();
+}
+
+const FRTSViewportSnapshot& URTSViewportSubsystem::GetViewportSnapshot()
+{
+	if (this->IsSnapshotOverridden || this->SnapshotFrameCounter == GFrameCounter)
+	{
+		return this->Snapshot;
+	}
+
+	this->SnapshotFrameCounter = GFrameCounter;
+
+	const auto GameViewport = this->GetWorld()->GetGameViewport();
+	if (GameViewport == nullptr || GameViewport->Viewport == nullptr)
+	{
+		this->Snapshot.IsCursorInViewport = false;
+		return this->Snapshot;
+	}
+
+	if (!this->IsViewportGeometryValid)
+	{
+		this->IsViewportGeometryValid = true;
+		this->Snapshot.ViewportSize = FVector2D(GameViewport->Viewport->GetSizeXY());
+		this->Snapshot.DPIScale = GameViewport->GetDPIScale();
+	}
+
+	// Keeps the last known position while the cursor is outside of the viewport
+	FVector2D CursorPosition;
+	this->Snapshot.IsCursorInViewport = GameViewport->GetMousePosition(CursorPosition);
+	if (this->Snapshot.IsCursorInViewport)
+	{
+		this->Snapshot.CursorPosition = CursorPosition;
+	}
+
+	return this->Snapshot;
+}
+
+void URTSViewportSubsystem::SetViewportSnapshotOverride(const FRTSViewportSnapshot& Override)
+{
+	this->Snapshot = Override;
+	this->IsSnapshotOverridden = true;
+}
+
+void URTSViewportSubsystem::ClearViewportSnapshotOverride()
+{
+	// Capture the real viewport again on next use
+	this->IsSnapshotOverridden = false;
+	this->IsViewportGeometryValid = false;
+	this->SnapshotFrameCounter = TNumericLimits<uint64>::Max();
+}
+
+void URTSViewportSubsystem::OnViewportResized(FViewport*, uint32)
+{
+	this->IsViewportGeometryValid = false;
+}
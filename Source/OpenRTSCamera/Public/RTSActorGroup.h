@@ -0,0 +1,107 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "UObject/Object.h"
+#include "RTSActorGroup.generated.h"
+
+/**
+ * A set of actors whose centroid and bounds are kept up to date incrementally.
+ *
+ * The sum of member locations is adjusted whenever a member is added, removed or moves, so the centroid never has to
+ * be recomputed over all members. The bounds are tracked per axis by six indexed heaps that keep the member with the
+ * lowest and highest coordinate on top, so a move only sifts the moved member and reading the bounds is constant
+ * time, even while the whole group is on the move. Members leave the group automatically when they end play.
+ */
+UCLASS(BlueprintType)
+class OPENRTSCAMERA_API URTSActorGroup : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Group")
+	void AddActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Group")
+	void RemoveActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Group")
+	void SetActors(const TArray<AActor*>& Actors);
+
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Group")
+	void Reset();
+
+	UFUNCTION(BlueprintPure, Category = "RTSCamera - Group")
+	bool Contains(const AActor* Actor) const;
+
+	UFUNCTION(BlueprintPure, Category = "RTSCamera - Group")
+	int32 Num() const;
+
+	UFUNCTION(BlueprintPure, Category = "RTSCamera - Group")
+	TArray<AActor*> GetActors() const;
+
+	/** Average location of the members, or the zero vector for an empty group. */
+	UFUNCTION(BlueprintPure, Category = "RTSCamera - Group")
+	FVector GetCentroid() const;
+
+	/** Axis aligned bounds of the member locations, or an invalid box for an empty group. */
+	UFUNCTION(BlueprintPure, Category = "RTSCamera - Group")
+	FBox GetBounds() const;
+
+private:
+	void OnMemberTransformUpdated(
+		USceneComponent* UpdatedComponent,
+		EUpdateTransformFlags Flags,
+		ETeleportType Teleport
+	);
+
+	UFUNCTION()
+	void OnMemberEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	// Member indices ordered by one coordinate, with the most extreme member at the top
+	struct FExtremumHeap
+	{
+		int32 Axis = 0;
+
+		// 1 keeps the highest coordinate on top, -1 the lowest
+		double Sign = 1.0;
+
+		TArray<int32> Heap;
+
+		// Position of each member in Heap, indexed like the member arrays
+		TArray<int32> Positions;
+	};
+
+	static constexpr int32 NumExtremumHeaps = 6;
+
+	void UnbindMember(int32 Index);
+
+	void AddToExtremumHeaps(int32 Index);
+	void UpdateInExtremumHeaps(int32 Index);
+	// Also moves the last member into Index, mirroring the swap removal of the member arrays
+	void RemoveFromExtremumHeaps(int32 Index);
+	double GetHeapKey(const FExtremumHeap& Heap, int32 Position) const;
+	void SwapHeapEntries(FExtremumHeap& Heap, int32 A, int32 B);
+	void SiftUp(FExtremumHeap& Heap, int32 Position);
+	void SiftDown(FExtremumHeap& Heap, int32 Position);
+
+	// Member arrays, all indexed the same way. Removal swaps the last member into the hole.
+	UPROPERTY()
+	TArray<AActor*> Members;
+	UPROPERTY()
+	TArray<USceneComponent*> MemberRoots;
+	TArray<FVector> MemberLocations;
+	TArray<FDelegateHandle> MemberTransformHandles;
+	TMap<const AActor*, int32> ActorToMember;
+	TMap<const USceneComponent*, int32> RootToMember;
+
+	FVector LocationSum = FVector::ZeroVector;
+
+	// Maximum X, Y and Z followed by minimum X, Y and Z
+	FExtremumHeap ExtremumHeaps[NumExtremumHeaps] = {
+		{0, 1.0}, {1, 1.0}, {2, 1.0},
+		{0, -1.0}, {1, -1.0}, {2, -1.0},
+	};
+};
@@ -4,25 +4,37 @@
 
 #include "CoreMinimal.h"
 #include "InputMappingContext.h"
+#include "RTSCameraBounds.h"
 #include "Camera/CameraComponent.h"
 #include "Components/ActorComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "RTSCamera.generated.h"
 
+class URTSActorGroup;
+class URTSCameraBoundsSubsystem;
+class URTSViewportSubsystem;
+
 /**
- * We use these commands so that move camera inputs can be tied to the tick rate of the game.
- * https://github.com/HeyZoos/OpenRTSCamera/issues/27
+ * The part of the camera that the tick stages work on. Stages only modify this struct, it is written to the scene
+ * components once at the end of the tick so that transforms are only propagated to the attached components once.
+ *
+ * Everything a stage needs from the world is gathered into it on the game thread first, so that the stages themselves
+ * can run for many cameras in parallel.
  */
-USTRUCT()
-struct FMoveCameraCommand
+struct FRTSCameraState
 {
-	GENERATED_BODY()
-	UPROPERTY()
-	float X = 0;
-	UPROPERTY()
-	float Y = 0;
-	UPROPERTY()
-	float Scale = 0;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	float ArmLength = 0;
+
+	float DeltaSeconds = 0;
+	FVector2D Movement = FVector2D::ZeroVector;
+	float YawDelta = 0;
+	bool IsEdgeScrolling = false;
+	FVector2D MousePosition = FVector2D::ZeroVector;
+	FVector2D ViewportSize = FVector2D::ZeroVector;
+	bool IsFollowingTarget = false;
+	FVector FollowTargetLocation = FVector::ZeroVector;
 };
 
 UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -30,26 +42,48 @@ class OPENRTSCAMERA_API URTSCamera : public UActorComponent
 {
 	GENERATED_BODY()
 
+	// The subsystem runs the tick stages of every camera
+	friend class URTSCameraSubsystem;
+
 public:
 	URTSCamera();
 
-	virtual void TickComponent(
-		float DeltaTime,
-		ELevelTick TickType,
-		FActorComponentTickFunction* ThisTickFunction
-	) override;
-
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
 	void FollowTarget(AActor* Target);
 
+	/** Follows the centroid of Targets, see `FollowGroup`. */
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
+	void FollowTargets(const TArray<AActor*>& Targets);
+
+	/**
+	 * Follows the centroid of a group that may change while it is followed, e.g. `URTSSelector::GetSelectionGroup`.
+	 * With `EnableGroupFraming` the zoom is chosen so that the whole group stays in view.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
+	void FollowGroup(URTSActorGroup* Group);
+
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
 	void UnFollowTarget();
 
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
-	void SetActiveCamera() const;
+	void SetActiveCamera();
 	
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
-	void JumpTo(FVector Position) const;
+	void JumpTo(FVector Position);
+
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
+	void SetZoomLength(float ZoomLength);
+
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
+	void RotateCamera(float YawDelta);
+
+	/**
+	 * The camera stops updating while it has nothing to do (no input, zoom or follow target, and the cursor outside of
+	 * the edge scrolling bands). Everything on this component and bounds or heightfield changes wake it up, call this
+	 * after changing its settings from elsewhere.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera")
+	void WakeUp();
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Zoom Settings")
 	float MinimumZoomLength;
@@ -60,6 +94,17 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Zoom Settings")
 	float ZoomSpeed;
 
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Follow Settings")
+	bool EnableGroupFraming;
+	// How much room to leave around a followed group, 1 fits its bounding circle exactly
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Follow Settings",
+		meta=(EditCondition="EnableGroupFraming", ClampMin="1.0")
+	)
+	float GroupFramingPadding;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera")
 	float StartingYAngle;
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera")
@@ -101,6 +146,17 @@ public:
 		meta=(EditCondition="EnableDynamicCameraHeight")
 	)
 	float FindGroundTraceLength;
+	/**
+	 * Trace for the ground asynchronously and apply last frame's result instead of blocking the game thread.
+	 * The camera height then lags one frame behind its movement, which the spring arm lag usually hides.
+	 */
+	UPROPERTY(
+		BlueprintReadWrite,
+		EditAnywhere,
+		Category = "RTSCamera - Dynamic Camera Height Settings",
+		meta=(EditCondition="EnableDynamicCameraHeight")
+	)
+	bool EnableAsyncGroundTrace;
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Edge Scroll Settings")
 	bool EnableEdgeScrolling;
@@ -138,6 +194,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	void OnZoomCamera(const FInputActionValue& Value);
 	void OnRotateCamera(const FInputActionValue& Value);
@@ -148,7 +205,9 @@ protected:
 	void OnDragCamera(const FInputActionValue& Value);
 
 	void RequestMoveCamera(float X, float Y, float Scale);
-	void ApplyMoveCameraCommands();
+	void RequestRotateCamera(float YawDelta);
+	void ApplyMoveCameraCommands(FRTSCameraState& State) const;
+	void ApplyRotateCameraCommands(FRTSCameraState& State) const;
 
 	UPROPERTY()
 	AActor* Owner;
@@ -161,42 +220,69 @@ protected:
 	UPROPERTY()
 	APlayerController* PlayerController;
 	UPROPERTY()
-	AActor* BoundaryVolume;
+	URTSCameraBoundsSubsystem* BoundsSubsystem;
+	UPROPERTY()
+	URTSViewportSubsystem* ViewportSubsystem;
 	UPROPERTY()
 	float DesiredZoomLength;
 
 private:
 	void CollectComponentDependencyReferences();
 	void ConfigureSpringArm();
-	void TryToFindBoundaryVolumeReference();
+	void BindToBoundsSubsystem();
+	void OnCameraBoundsChanged();
 	void ConditionallyEnableEdgeScrolling() const;
 	void CheckForEnhancedInputComponent() const;
 	void BindInputMappingContext() const;
 	void BindInputActions();
 
-	void ConditionallyPerformEdgeScrolling() const;
-	void EdgeScrollLeft() const;
-	void EdgeScrollRight() const;
-	void EdgeScrollUp() const;
-	void EdgeScrollDown() const;
+	// Tick stages, run by `URTSCameraSubsystem` in this order. Only the const ones may run on worker threads.
+	bool GatherCameraState(FRTSCameraState& State, float DeltaTime);
+	void UpdateCameraMovement(FRTSCameraState& State) const;
+	void ConditionallyKeepCameraAtDesiredZoomAboveGround(FRTSCameraState& State);
+	void UpdateCameraFraming(FRTSCameraState& State) const;
+	bool CommitCameraState(const FRTSCameraState& State) const;
+	void ConditionallyFallAsleep(bool DidCameraChange);
 
-	void FollowTargetIfSet() const;
-	void SmoothTargetArmLengthToDesiredZoom() const;
-	void ConditionallyKeepCameraAtDesiredZoomAboveGround();
-	void ConditionallyApplyCameraBounds() const;
+	bool HasPendingWork() const;
+	bool IsCursorInEdgeBand() const;
+
+	void ConditionallyPerformEdgeScrolling(FRTSCameraState& State) const;
+	// How far the cursor is into the edge bands, from -1 (left/top) to 1 (right/bottom) per axis
+	FVector2D GetEdgeScroll(const FVector2D& MousePosition, const FVector2D& ViewportSize) const;
+
+	void FollowTargetIfSet(FRTSCameraState& State) const;
+	float GetGroupFramingZoomLength(const FBox& GroupBounds) const;
+	void SmoothTargetArmLengthToDesiredZoom(FRTSCameraState& State) const;
+	void KeepCameraAboveGround(FRTSCameraState& State);
+	void KeepCameraAboveGroundAsync(FRTSCameraState& State);
+	void GetGroundTraceEndpoints(const FVector& Location, FVector& OutStart, FVector& OutEnd) const;
+	void ReportCameraNotOnGround();
+	void ConditionallyApplyCameraBounds(FRTSCameraState& State) const;
 
-	UPROPERTY()
-	FName CameraBlockingVolumeTag;
 	UPROPERTY()
 	AActor* CameraFollowTarget;
 	UPROPERTY()
-	float DeltaSeconds;
+	URTSActorGroup* CameraFollowGroup;
+	// Group created for `FollowTargets`, reused between calls
+	UPROPERTY()
+	URTSActorGroup* FollowTargetsGroup;
+	bool IsAwake;
 	UPROPERTY()
 	bool IsCameraOutOfBoundsErrorAlreadyDisplayed;
+	FTraceHandle GroundTraceHandle;
+	// Copy of the bounds subsystem's union of every boundary volume, updated only when a volume changes
+	FRTSCameraBounds CameraBounds;
 	UPROPERTY()
 	bool IsDragging;
 	UPROPERTY()
 	FVector2D DragStartLocation;
+	/**
+	 * Move camera inputs are summed here and applied on tick so that they are tied to the tick rate of the game.
+	 * https://github.com/HeyZoos/OpenRTSCamera/issues/27
+	 */
+	UPROPERTY()
+	FVector2D PendingMovement;
 	UPROPERTY()
-	TArray<FMoveCameraCommand> MoveCameraCommands;
+	float PendingYawDelta;
 };
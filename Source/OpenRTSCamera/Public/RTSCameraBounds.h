@@ -0,0 +1,48 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A convex polygon in the XY plane, stored both as its counter-clockwise vertices and as the half-planes of its edges.
+ * A point is inside when `Normal | Point <= Distance` holds for every half-plane.
+ */
+struct OPENRTSCAMERA_API FRTSCameraBoundsPolygon
+{
+	/** Builds the convex hull of Points. Returns an empty polygon if the points do not span an area. */
+	static FRTSCameraBoundsPolygon MakeConvexHull(TArray<FVector2D> Points);
+
+	static FRTSCameraBoundsPolygon MakeBox(const FBox2D& Box);
+
+	bool IsValid() const;
+	bool Contains(const FVector2D& Point) const;
+	FVector2D GetClosestPoint(const FVector2D& Point) const;
+
+	TArray<FVector2D> Vertices;
+	TArray<FVector2D> Normals;
+	TArray<double> Distances;
+
+private:
+	void BuildHalfPlanes();
+};
+
+/**
+ * The area the camera is allowed to move in, as a union of convex polygons (e.g. an L-shaped map is two of them)
+ * together with the vertical range they were built from.
+ */
+struct OPENRTSCAMERA_API FRTSCameraBounds
+{
+	void Reset();
+	void AddPolygon(FRTSCameraBoundsPolygon&& Polygon, double InMinimumZ, double InMaximumZ);
+	void Append(const FRTSCameraBounds& Other);
+
+	bool IsEmpty() const;
+
+	/** Returns Location unchanged when inside any polygon, otherwise moved horizontally onto the closest edge. */
+	FVector Clamp(const FVector& Location) const;
+
+	TArray<FRTSCameraBoundsPolygon> Polygons;
+	double MinimumZ = TNumericLimits<double>::Max();
+	double MaximumZ = TNumericLimits<double>::Lowest();
+};
@@ -0,0 +1,62 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSCameraBounds.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSCameraBoundsSubsystem.generated.h"
+
+class ARTSCameraBoundsVolume;
+
+DECLARE_MULTICAST_DELEGATE(FOnRTSCameraBoundsSetChanged);
+DECLARE_MULTICAST_DELEGATE(FOnRTSCameraHeightfieldInvalidated);
+
+/**
+ * Keeps track of every `ARTSCameraBoundsVolume` that is currently in play.
+ *
+ * Volumes register themselves on `BeginPlay` and unregister on `EndPlay`, so volumes in streamed levels or World
+ * Partition cells are picked up as they load. The union of their bounds is kept up to date here and cameras are
+ * notified whenever it changes.
+ *
+ * Other actors tagged `OpenRTSCamera#CameraBounds`, which bounded the camera before volumes registered themselves,
+ * are deprecated. Those in the world when play begins still add their axis aligned bounds, with a warning.
+ */
+UCLASS()
+class OPENRTSCAMERA_API URTSCameraBoundsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void RegisterBoundsVolume(ARTSCameraBoundsVolume* Volume);
+	void UnregisterBoundsVolume(ARTSCameraBoundsVolume* Volume);
+
+	/** The union of the bounds of every registered volume. Empty if there is no volume. */
+	const FRTSCameraBounds& GetCameraBounds() const;
+
+	/** Samples the heightfield of the first registered volume that has one covering Location. */
+	bool SampleHeightfield(const FVector& Location, float& OutHeight) const;
+
+	/** Broadcast after a volume was added, removed or moved. */
+	FOnRTSCameraBoundsSetChanged OnCameraBoundsChanged;
+
+	/** Called by volumes when part of their heightfield is invalidated, so that sleeping cameras settle again. */
+	void NotifyHeightfieldInvalidated();
+
+	FOnRTSCameraHeightfieldInvalidated OnHeightfieldInvalidated;
+
+private:
+	void OnBoundsVolumeChanged(ARTSCameraBoundsVolume* Volume);
+	void RebuildCameraBounds();
+
+	UPROPERTY()
+	TArray<ARTSCameraBoundsVolume*> BoundsVolumes;
+
+	// Deprecated tagged actors that are not volumes, only gathered once when play begins
+	UPROPERTY()
+	TArray<AActor*> LegacyBoundsActors;
+
+	FRTSCameraBounds CameraBounds;
+};
@@ -3,13 +3,72 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RTSCameraBounds.h"
 #include "GameFramework/CameraBlockingVolume.h"
 #include "RTSCameraBoundsVolume.generated.h"
 
+class ARTSCameraBoundsVolume;
+class URTSCameraHeightfield;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnRTSCameraBoundsChanged, ARTSCameraBoundsVolume*);
+
 UCLASS()
 class OPENRTSCAMERA_API ARTSCameraBoundsVolume : public ACameraBlockingVolume
 {
 	GENERATED_BODY()
 
 	ARTSCameraBoundsVolume();
+
+public:
+	/**
+	 * Baked ground heights over this volume. When set, `URTSCamera` samples it instead of tracing for the ground.
+	 * Use "Bake Heightfield" to (re)generate it. If none is assigned, a new heightfield asset is created and saved
+	 * next to the level, so copies of the volume share the bake instead of each embedding their own.
+	 */
+	UPROPERTY(EditAnywhere, Category = "RTSCamera - Heightfield")
+	URTSCameraHeightfield* Heightfield;
+
+	UPROPERTY(EditAnywhere, Category = "RTSCamera - Heightfield", meta = (ClampMin = "1.0"))
+	float HeightfieldCellSize;
+
+	UPROPERTY(EditAnywhere, Category = "RTSCamera - Heightfield")
+	TEnumAsByte<ECollisionChannel> HeightfieldCollisionChannel;
+
+	UFUNCTION(CallInEditor, Category = "RTSCamera - Heightfield")
+	void BakeHeightfield();
+
+	// Re-traces the heightfield within Region the next time the camera passes over it, e.g. after placing a building
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Heightfield")
+	void InvalidateHeightfield(const FBox& Region);
+
+	/** Returns false if there is no baked heightfield covering Location. */
+	bool SampleHeightfield(const FVector& Location, float& OutHeight) const;
+
+	/**
+	 * The XY area covered by the brush, one convex polygon per convex element of the brush. Cached when the volume is
+	 * initialized and whenever it moves.
+	 */
+	const FRTSCameraBounds& GetCameraBounds() const;
+
+	/** Broadcast after the cached camera bounds were rebuilt. */
+	FOnRTSCameraBoundsChanged OnCameraBoundsChanged;
+
+protected:
+	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+#if WITH_EDITOR
+	URTSCameraHeightfield* CreateHeightfieldAsset() const;
+#endif
+
+	void UpdateCameraBounds();
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags Flags, ETeleportType Teleport);
+
+	FRTSCameraBounds CameraBounds;
+
+	// Per-world copy of the heightfield, so that runtime invalidation never touches the baked asset
+	UPROPERTY(Transient)
+	URTSCameraHeightfield* RuntimeHeightfield;
 };
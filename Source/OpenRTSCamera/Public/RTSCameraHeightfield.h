@@ -0,0 +1,77 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "RTSCameraHeightfield.generated.h"
+
+/**
+ * Ground heights sampled over the XY extents of a `ARTSCameraBoundsVolume`, quantized to 16 bits.
+ *
+ * Baked in the editor from the volume's details panel, then sampled with bilinear interpolation by `URTSCamera`
+ * instead of tracing for the ground every tick. Regions can be invalidated at runtime (for example when a building
+ * is placed), their tiles are then re-traced lazily the next time the camera samples them.
+ */
+UCLASS(BlueprintType)
+class OPENRTSCAMERA_API URTSCameraHeightfield : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Traces the ground at every sample point within Bounds, quantizing heights over the Z range of Bounds. */
+	void Bake(
+		const UWorld* World,
+		const FBox& Bounds,
+		float InCellSize,
+		ECollisionChannel CollisionChannel,
+		const AActor* ActorToIgnore
+	);
+
+	bool IsBaked() const;
+	bool ContainsLocation(const FVector& Location) const;
+
+	/** Returns the ground height below Location, re-tracing any invalidated tile that the sample touches. */
+	float SampleHeight(const FVector& Location);
+
+	/** Marks every tile that overlaps Region as stale. */
+	void InvalidateRegion(const FBox& Region);
+
+	/** Sets up the world used to re-trace invalidated tiles, called when the owning volume begins play. */
+	void SetRuntimeTraceContext(const UWorld* World, const AActor* ActorToIgnore);
+
+	UPROPERTY(VisibleAnywhere, Category = "RTSCamera - Heightfield")
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "RTSCamera - Heightfield")
+	float CellSize = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "RTSCamera - Heightfield")
+	FIntPoint Resolution = FIntPoint::ZeroValue;
+
+	UPROPERTY(VisibleAnywhere, Category = "RTSCamera - Heightfield")
+	float MinimumHeight = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "RTSCamera - Heightfield")
+	float HeightStep = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "RTSCamera - Heightfield")
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_WorldStatic;
+
+	UPROPERTY()
+	TArray<uint16> Heights;
+
+private:
+	static constexpr int32 TileSize = 16;
+
+	float TraceHeight(const UWorld* World, const AActor* ActorToIgnore, int32 X, int32 Y) const;
+	float DecodeHeight(int32 X, int32 Y) const;
+	uint16 EncodeHeight(float Height) const;
+	int32 GetTileIndex(int32 X, int32 Y) const;
+	void RetraceTile(int32 TileIndex);
+
+	// Runtime only state used to lazily re-trace invalidated tiles
+	TBitArray<> DirtyTiles;
+	TWeakObjectPtr<const UWorld> TraceWorld;
+	TWeakObjectPtr<const AActor> TraceIgnoredActor;
+};
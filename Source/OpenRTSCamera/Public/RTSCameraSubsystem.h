@@ -0,0 +1,82 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSCamera.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSCameraSubsystem.generated.h"
+
+class URTSCameraSubsystem;
+
+/** Runs `URTSCameraSubsystem::Tick` in `TG_PrePhysics`, where the cameras used to tick as components. */
+USTRUCT()
+struct FRTSCameraSubsystemTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	URTSCameraSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(
+		float DeltaTime,
+		ELevelTick TickType,
+		ENamedThreads::Type CurrentThread,
+		const FGraphEventRef& MyCompletionGraphEvent
+	) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FRTSCameraSubsystemTickFunction> : public TStructOpsTypeTraitsBase2<
+	FRTSCameraSubsystemTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Updates every `URTSCamera` in the world from a single tick function.
+ *
+ * The state of all cameras is kept in one contiguous array. Each tick gathers the inputs of every awake camera on the
+ * game thread, runs the pure stages (movement, edge scrolling, zoom, follow and bounds) over all of them, in parallel
+ * once there are enough cameras, and then writes the results back to the scene components. Ground tracing stays on
+ * the game thread between the two groups of stages.
+ *
+ * The tick runs in `TG_PrePhysics` after the player controllers of the cameras, so that input is applied in the frame
+ * it arrives and the spring arms, attached components and anything else reading the camera this frame see the new
+ * transform.
+ */
+UCLASS()
+class OPENRTSCAMERA_API URTSCameraSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	void RegisterCamera(URTSCamera* Camera);
+	void UnregisterCamera(URTSCamera* Camera);
+
+	/** Updates every awake camera, called by the tick function once per frame. */
+	void Tick(float DeltaTime);
+
+private:
+	// Below this many active cameras the stages run on the game thread, where they are cheaper than a task dispatch
+	static constexpr int32 ParallelUpdateThreshold = 16;
+
+	void ForEachActiveCamera(TFunctionRef<void(URTSCamera&, FRTSCameraState&)> Stage, bool IsParallel);
+
+	UPROPERTY()
+	TArray<URTSCamera*> Cameras;
+	TArray<FRTSCameraState> States;
+
+	// Indices of the cameras that are updated this tick
+	TArray<int32> ActiveIndices;
+
+	FRTSCameraSubsystemTickFunction TickFunction;
+};
@@ -26,12 +26,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Selection Box")
 	void UpdateSelection(const FVector2D& EndPoint);
 
+	// Stops drawing the selection box, the selection itself is resolved by URTSSelector
 	UFUNCTION(BlueprintCallable, Category = "Selection Box")
 	void EndSelection();
 
 	UFUNCTION(BlueprintNativeEvent, Category = "Selection Box")
 	void DrawSelectionBox(const FVector2D& StartPoint, const FVector2D& EndPoint);
 
+	// Selects the units in the last drawn box through the owning player's URTSSelector. URTSSelector calls this when a
+	// box selection ends if a Blueprint overrides it, and resolves the box itself otherwise
 	UFUNCTION(BlueprintNativeEvent, Category = "Selection Box")
 	void PerformSelection();
 
@@ -40,7 +43,6 @@ protected:
 
 private:
 	bool bIsDrawingSelectionBox;
-	bool bIsPerformingSelection;
 	FVector2D SelectionStart;
 	FVector2D SelectionEnd;
 };
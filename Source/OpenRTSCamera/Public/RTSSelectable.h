@@ -1,4 +1,7 @@
 ﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
 #include "RTSSelectable.generated.h"
 
 UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -11,4 +14,59 @@ public:
 
 	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, Category = "RTS Selection")
 	void OnDeselected();
+
+	// Called while a selection box is being dragged over this selectable, use it for hover highlights
+	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, Category = "RTS Selection")
+	void OnPreviewEnter();
+
+	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, Category = "RTS Selection")
+	void OnPreviewExit();
+
+	// Recomputes the cached owner bounds, call this if the owner's components change size at runtime
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection")
+	void RefreshSelectionBounds();
+
+	// Stable slot of this selectable in the URTSSelectionSubsystem registry, INDEX_NONE while unregistered
+	int32 GetRegistrySlot() const;
+
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection")
+	void SetSelectable(bool InIsSelectable);
+
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection")
+	void SetTeamId(uint8 InTeamId);
+
+	UFUNCTION(BlueprintCallable, Category = "RTS Selection")
+	void SetCategoryMask(int32 InCategoryMask);
+
+	// Filter metadata packed the way FRTSSelectionFilter tests it
+	uint64 GetSelectionFilterBits() const;
+
+	// Selectables that are not selectable are skipped by selections and previews, e.g. while dying
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "RTS Selection")
+	bool IsSelectable = true;
+
+	// Owning team or player, matched against URTSSelector::SelectionFilter
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "RTS Selection")
+	uint8 TeamId = 0;
+
+	// Unit categories (e.g. infantry, vehicles, buildings) as bits, matched against URTSSelector::SelectionFilter
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "RTS Selection", meta = (Bitmask))
+	int32 CategoryMask = 1;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void BeginPlay() override;
+
+private:
+	void OnOwnerTransformUpdated(
+		USceneComponent* UpdatedComponent,
+		EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport
+	);
+
+	void UpdateRegistryFilterBits() const;
+
+	FDelegateHandle OwnerTransformUpdatedHandle;
+	int32 RegistrySlot = INDEX_NONE;
 };
@@ -0,0 +1,57 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A 32 bit reference to a registered `URTSSelectable`: its registry slot in the low bits and the generation of that
+ * slot in the high bits. The slot's generation changes when the selectable unregisters, so handles to destroyed
+ * selectables stop resolving even after the slot has been handed to someone else.
+ */
+struct OPENRTSCAMERA_API FRTSSelectableHandle
+{
+	static constexpr int32 SlotBits = 20;
+	static constexpr uint32 SlotMask = (1u << SlotBits) - 1;
+	static constexpr uint32 MaxGeneration = (1u << (32 - SlotBits)) - 1;
+
+	FRTSSelectableHandle() = default;
+
+	FRTSSelectableHandle(const int32 Slot, const uint32 Generation)
+		: Value(static_cast<uint32>(Slot) | Generation << SlotBits)
+	{
+	}
+
+	/** Generations start at 1, so only default constructed handles are unset. */
+	bool IsSet() const
+	{
+		return this->Value != 0;
+	}
+
+	int32 GetSlot() const
+	{
+		return static_cast<int32>(this->Value & SlotMask);
+	}
+
+	uint32 GetGeneration() const
+	{
+		return this->Value >> SlotBits;
+	}
+
+	bool operator==(const FRTSSelectableHandle& Other) const
+	{
+		return this->Value == Other.Value;
+	}
+
+	bool operator!=(const FRTSSelectableHandle& Other) const
+	{
+		return this->Value != Other.Value;
+	}
+
+	friend uint32 GetTypeHash(const FRTSSelectableHandle& Handle)
+	{
+		return Handle.Value;
+	}
+
+	uint32 Value = 0;
+};
@@ -0,0 +1,49 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSSelectionFilter.generated.h"
+
+/**
+ * Which selectables a selection may contain, tested natively against the metadata set on each `URTSSelectable`.
+ *
+ * The registry keeps that metadata packed into one 64 bit word per selectable (categories in the low 32 bits, then
+ * the team id and the selectable flag), so a whole candidate set is filtered with a mask and two compares each.
+ */
+USTRUCT(BlueprintType)
+struct OPENRTSCAMERA_API FRTSSelectionFilter
+{
+	GENERATED_BODY()
+
+	// Only select selectables of TeamId
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	bool FilterByTeam = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection", meta = (EditCondition = "FilterByTeam"))
+	uint8 TeamId = 0;
+
+	// Selectables pass if they share at least one category with this mask
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection", meta = (Bitmask))
+	int32 CategoryMask = -1;
+
+	static constexpr uint64 CategoryBits = 0xFFFFFFFFull;
+	static constexpr int32 TeamShift = 32;
+	static constexpr uint64 TeamBits = 0xFFull << TeamShift;
+	static constexpr uint64 SelectableBit = 1ull << 40;
+
+	static uint64 PackSelectableBits(const uint8 InTeamId, const int32 InCategoryMask, const bool IsSelectable)
+	{
+		return static_cast<uint32>(InCategoryMask)
+			| static_cast<uint64>(InTeamId) << TeamShift
+			| (IsSelectable ? SelectableBit : 0);
+	}
+
+	bool Passes(const uint64 Bits) const
+	{
+		const auto RequiredMask = SelectableBit | (this->FilterByTeam ? TeamBits : 0);
+		const auto RequiredBits = SelectableBit | static_cast<uint64>(this->TeamId) << TeamShift;
+		return ((Bits & RequiredMask) == (RequiredBits & RequiredMask))
+			& ((Bits & static_cast<uint32>(this->CategoryMask)) != 0);
+	}
+};
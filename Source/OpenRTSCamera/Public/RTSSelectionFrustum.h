@@ -0,0 +1,53 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The four side planes of the frustum spanned by a screen-space selection rectangle.
+ *
+ * Built from the deprojected rectangle corners (in clockwise screen order), so it works for both perspective and
+ * orthographic views. Planes point inwards: a point is inside when `Plane.PlaneDot(Point) >= 0` for all four.
+ */
+struct OPENRTSCAMERA_API FRTSSelectionFrustum
+{
+	FRTSSelectionFrustum() = default;
+	FRTSSelectionFrustum(const FVector (&InCornerOrigins)[4], const FVector (&InCornerDirections)[4]);
+
+	/** Normalizes two screen points into a rectangle that is at least a pixel wide in both directions. */
+	static FBox2D MakeScreenRectangle(const FVector2D& A, const FVector2D& B);
+
+	/** Returns the rectangle corners in the clockwise order expected by the constructor. */
+	static void GetScreenRectangleCorners(const FBox2D& Rectangle, FVector2D (&OutCorners)[4]);
+
+	bool IntersectsSphere(const FVector& Center, float Radius) const;
+
+	/**
+	 * Appends to `OutIndices` the index of every sphere that touches the frustum. Spheres are given as separate
+	 * X/Y/Z/radius arrays of `Count` elements and are tested four at a time with vector intrinsics.
+	 */
+	void CullSpheres(
+		const float* X,
+		const float* Y,
+		const float* Z,
+		const float* Radius,
+		int32 Count,
+		TArray<int32>& OutIndices
+	) const;
+
+	/** Reference implementation of `CullSpheres`, one sphere at a time. */
+	void CullSpheresScalar(
+		const float* X,
+		const float* Y,
+		const float* Z,
+		const float* Radius,
+		int32 Count,
+		TArray<int32>& OutIndices,
+		int32 FirstIndex = 0
+	) const;
+
+	FVector CornerOrigins[4];
+	FVector CornerDirections[4];
+	FPlane Planes[4];
+};
@@ -0,0 +1,64 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSSelectionListener.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "RTSSelectionIndicatorComponent.generated.h"
+
+class URTSSelectionSubsystem;
+
+/**
+ * Draws a selection ring under every selected selectable as one instance of a single instanced static mesh.
+ *
+ * Created by `URTSSelector` when `EnableSelectionIndicators` is set and registered as one of its selection listeners,
+ * so instances are added and removed in bulk as the selection changes. While anything is selected, the instance
+ * transforms are refreshed once per frame from the positions cached in `URTSSelectionSubsystem`, and only pushed to
+ * the renderer when one of them actually moved.
+ */
+UCLASS(ClassGroup=(Custom))
+class OPENRTSCAMERA_API URTSSelectionIndicatorComponent : public UInstancedStaticMeshComponent,
+                                                          public IRTSSelectionListener
+{
+	GENERATED_BODY()
+
+public:
+	URTSSelectionIndicatorComponent();
+
+	virtual void TickComponent(
+		float DeltaTime,
+		ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction
+	) override;
+
+	virtual void OnSelectablesSelected(TConstArrayView<URTSSelectable*> Selectables) override;
+	virtual void OnSelectablesDeselected(TConstArrayView<URTSSelectable*> Selectables) override;
+
+	// Ring radius as a multiple of the selectable's bounds radius
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	float IndicatorRadiusScale;
+
+	// Radius of the indicator mesh at a scale of 1, 50 for the engine's plane
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	float IndicatorMeshRadius;
+
+	// Added to the selectable's location, e.g. to move the ring from a capsule's center down to its feet
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	FVector IndicatorOffset;
+
+private:
+	FTransform MakeIndicatorTransform(const URTSSelectionSubsystem* Registry, const URTSSelectable* Selectable) const;
+
+	// Rebuilds InstanceTransforms from the registry, returns whether any of them changed
+	bool RefreshInstanceTransforms();
+
+	// Selectable drawn by each instance, and the transform that instance was last given
+	UPROPERTY()
+	TArray<URTSSelectable*> IndicatedSelectables;
+	TArray<FTransform> InstanceTransforms;
+
+	// Scratch state reused between selection changes
+	TArray<FTransform> NewInstanceTransforms;
+	TSet<const URTSSelectable*> DeselectedSelectables;
+};
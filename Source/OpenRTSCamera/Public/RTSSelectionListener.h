@@ -0,0 +1,37 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "RTSSelectionListener.generated.h"
+
+class URTSSelectable;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class URTSSelectionListener : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Native listener for selection changes, registered with `URTSSelector::AddSelectionListener`.
+ *
+ * Receives every change as a span of selectables instead of one Blueprint event per selectable, e.g. to toggle all
+ * selection decals in one go. Spans arrive in the order the selection changed, and may be split across frames when
+ * the selector has a notification budget, so a span can contain selectables that have been destroyed since.
+ * The span is only valid for the duration of the call, and the selection must not be changed from inside it.
+ */
+class OPENRTSCAMERA_API IRTSSelectionListener
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnSelectablesSelected(TConstArrayView<URTSSelectable*> Selectables)
+	{
+	}
+
+	virtual void OnSelectablesDeselected(TConstArrayView<URTSSelectable*> Selectables)
+	{
+	}
+};
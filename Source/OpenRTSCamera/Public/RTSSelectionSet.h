@@ -0,0 +1,69 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSSelectableHandle.h"
+#include "RTSSelectionSubsystem.h"
+
+/**
+ * An ordered set of selectables that holds no UObject references, so the garbage collector never has to scan it.
+ *
+ * Handles are kept in a dense array next to one membership bit per registry slot, which makes add, remove and
+ * contains constant time. Removing only clears the bit and leaves a tombstone in the array; tombstones are compacted
+ * away by a later add once they make up half of the array, so removing while iterating `GetHandles` is safe.
+ * Handles to selectables that have unregistered since are skipped by `ForEach` and dropped by `Prune`, which `Add`
+ * runs first so that a reused slot is never mistaken for its previous selectable.
+ */
+struct OPENRTSCAMERA_API FRTSSelectionSet
+{
+	/** Returns false if the handle does not resolve or is already part of the set. */
+	bool Add(const URTSSelectionSubsystem& Registry, FRTSSelectableHandle Handle);
+	bool Remove(FRTSSelectableHandle Handle);
+	bool Contains(const URTSSelectionSubsystem& Registry, FRTSSelectableHandle Handle) const;
+	void Reset();
+
+	/** Drops the handles of selectables that have unregistered since the last prune. */
+	void Prune(const URTSSelectionSubsystem& Registry);
+
+	/** Number of members, including any that have unregistered since the last prune. */
+	int32 Num() const;
+	bool IsEmpty() const;
+
+	/** Calls Function(Handle, Slot) for every live member, in the order they were added. */
+	template <typename FunctionType>
+	void ForEach(const URTSSelectionSubsystem& Registry, FunctionType&& Function) const;
+
+	/** Every handle in insertion order, including tombstones and members that have unregistered since. */
+	TConstArrayView<FRTSSelectableHandle> GetHandles() const;
+	bool IsMember(FRTSSelectableHandle Handle) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void Compact(const URTSSelectionSubsystem* Registry);
+
+	TArray<FRTSSelectableHandle> Handles;
+	TBitArray<> MemberSlots;
+	TBitArray<> TombstoneSlots;
+	int32 NumTombstones = 0;
+
+	// URTSSelectionSubsystem::GetNumRemovals at the last prune, anything else means members may have gone stale
+	uint32 PrunedNumRemovals = 0;
+};
+
+template <typename FunctionType>
+void FRTSSelectionSet::ForEach(const URTSSelectionSubsystem& Registry, FunctionType&& Function) const
+{
+	for (const auto Handle : this->Handles)
+	{
+		if (this->IsMember(Handle))
+		{
+			const auto Slot = Registry.ResolveHandle(Handle);
+			if (Slot != INDEX_NONE)
+			{
+				Function(Handle, Slot);
+			}
+		}
+	}
+}
@@ -0,0 +1,170 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSSelectableHandle.h"
+#include "RTSSelectionFilter.h"
+#include "RTSSelectionFrustum.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSSelectionSubsystem.generated.h"
+
+class URTSSelectable;
+
+/**
+ * Registry of every `URTSSelectable` in the world.
+ *
+ * Selectables are stored in dense, contiguous arrays (component, owner, cached position, bounds radius) so that
+ * queries can iterate only selectables without any per-actor component lookups. Positions are kept as separate
+ * X/Y/Z arrays so that frustum tests can run over them with vector intrinsics. Each selectable also gets a stable
+ * slot index for its whole registration; the dense index of a slot may change when other selectables unregister.
+ *
+ * On top of the registry sits a uniform XY grid of slots so that selection queries only have to look at the cells
+ * under the selection frustum instead of sweeping every actor in the world, and an index of slots by owner class
+ * so that "select all of this type" only looks at selectables of that type.
+ */
+UCLASS(Config=OpenRTSCamera)
+class OPENRTSCAMERA_API URTSSelectionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	URTSSelectionSubsystem();
+
+	/** Returns the stable slot of the selectable, or INDEX_NONE if its owner already has a registered selectable. */
+	int32 RegisterSelectable(URTSSelectable* Selectable);
+	void UnregisterSelectable(int32 Slot);
+
+	/** Updates the cached position and re-buckets the selectable if it moved into a different grid cell. */
+	void UpdateSelectableLocation(int32 Slot, const FVector& Location);
+	void UpdateSelectableBoundsRadius(int32 Slot, float BoundsRadius);
+	void UpdateSelectableFilterBits(int32 Slot, uint64 FilterBits);
+
+	/** Appends the slot of every selectable whose bounds sphere touches the frustum. */
+	void QuerySelectablesInFrustum(const FRTSSelectionFrustum& Frustum, TArray<int32>& OutSlots) const;
+
+	/**
+	 * Collects the slots whose grid cell lies under the footprint of the frustum. The footprint is the XY extent of
+	 * the frustum between the lowest and highest registered selectable, so the result is a conservative candidate
+	 * set that still has to be tested against the frustum itself.
+	 */
+	void GatherSelectablesInFrustum(const FRTSSelectionFrustum& Frustum, TArray<int32>& OutSlots) const;
+
+	void GatherSelectablesInFootprint(const FBox2D& Footprint, TArray<int32>& OutSlots) const;
+
+	/** Appends the slot of every selectable whose owner is exactly of Class and whose bounds touch the frustum. */
+	void QuerySelectablesOfClassInFrustum(
+		const UClass* Class,
+		const FRTSSelectionFrustum& Frustum,
+		TArray<int32>& OutSlots
+	) const;
+
+	/** Slots of every selectable whose owner is exactly of Class. */
+	TConstArrayView<int32> GetSlotsOfClass(const UClass* Class) const;
+
+	/** Removes every slot whose selectable does not pass Filter, keeping the order of the remaining slots. */
+	void FilterSlots(const FRTSSelectionFilter& Filter, TArray<int32>& InOutSlots) const;
+
+	/**
+	 * Returns the slot of the selectable whose bounds sphere the ray enters first, or INDEX_NONE. Spheres are grown by
+	 * `ToleranceRadius + ToleranceSlope * Distance` along the ray, which expresses a constant screen space tolerance
+	 * for both orthographic (slope 0) and perspective (radius 0) views.
+	 */
+	int32 PickSelectable(
+		const FVector& RayOrigin,
+		const FVector& RayDirection,
+		float ToleranceRadius,
+		float ToleranceSlope
+	) const;
+
+	/** Returns the slot of the selectable on the given actor, or INDEX_NONE. */
+	int32 FindSlotByOwner(const AActor* Owner) const;
+
+	bool IsValidSlot(int32 Slot) const;
+
+	/** Returns an unset handle for slots that are not registered. */
+	FRTSSelectableHandle GetHandle(int32 Slot) const;
+
+	/** Returns the slot of the handle, or INDEX_NONE if its selectable has unregistered since. */
+	int32 ResolveHandle(FRTSSelectableHandle Handle) const;
+	URTSSelectable* GetSelectable(FRTSSelectableHandle Handle) const;
+
+	/** Number of unregistrations so far, lets handle containers tell cheaply whether any handle may have gone stale. */
+	uint32 GetNumRemovals() const;
+
+	int32 GetDenseIndex(int32 Slot) const;
+	int32 GetSlot(int32 DenseIndex) const;
+
+	/** Upper bound (exclusive) of every slot handed out so far, useful for sizing per-slot bit arrays. */
+	int32 GetSlotCapacity() const;
+	int32 GetNumSelectables() const;
+
+	URTSSelectable* GetSelectable(int32 Slot) const;
+	AActor* GetOwner(int32 Slot) const;
+	FVector GetLocation(int32 Slot) const;
+	float GetBoundsRadius(int32 Slot) const;
+	uint64 GetFilterBits(int32 Slot) const;
+
+	TConstArrayView<URTSSelectable*> GetSelectables() const;
+	TConstArrayView<AActor*> GetOwners() const;
+	TConstArrayView<float> GetLocationsX() const;
+	TConstArrayView<float> GetLocationsY() const;
+	TConstArrayView<float> GetLocationsZ() const;
+	TConstArrayView<float> GetBoundsRadii() const;
+
+	/** World size of one grid cell edge. Should be a few times larger than a typical unit. */
+	UPROPERTY(Config)
+	float GridCellSize;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(const FIntPoint& Cell, int32 Slot);
+	void RemoveFromCell(const FIntPoint& Cell, int32 Slot);
+	void GatherAllSelectables(TArray<int32>& OutSlots) const;
+
+	// Culls candidate slots against the frustum after copying their spheres into contiguous scratch arrays
+	void CullCandidateSlots(
+		const FRTSSelectionFrustum& Frustum,
+		TConstArrayView<int32> CandidateSlots,
+		TArray<int32>& OutSlots
+	) const;
+
+	// Dense arrays, all indexed by the same dense index.
+	UPROPERTY()
+	TArray<URTSSelectable*> Selectables;
+	UPROPERTY()
+	TArray<AActor*> Owners;
+	TArray<float> LocationsX;
+	TArray<float> LocationsY;
+	TArray<float> LocationsZ;
+	TArray<float> BoundsRadii;
+	TArray<uint64> FilterBits;
+	TArray<FIntPoint> DenseCells;
+	TArray<int32> DenseToSlot;
+
+	// Stable slot -> dense index indirection, INDEX_NONE marks a free slot.
+	TArray<int32> SlotToDense;
+	TArray<uint16> SlotGenerations;
+	uint32 NumRemovals;
+	TArray<int32> FreeSlots;
+	TMap<const AActor*, int32> OwnerToSlot;
+
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// Slots by the exact class of their owner, and the position of each slot within its class bucket.
+	TMap<const UClass*, TArray<int32>> ClassToSlots;
+	TArray<int32> SlotToClassIndex;
+
+	// Conservative (grow only) vertical range and footprint padding of everything that has been registered.
+	float MinimumZ;
+	float MaximumZ;
+	float MaximumBoundsRadius;
+
+	// Scratch buffers for gathering grid candidates into contiguous arrays before culling them.
+	mutable TArray<int32> ScratchSlots;
+	mutable TArray<int32> ScratchIndices;
+	mutable TArray<float> ScratchX;
+	mutable TArray<float> ScratchY;
+	mutable TArray<float> ScratchZ;
+	mutable TArray<float> ScratchRadii;
+};
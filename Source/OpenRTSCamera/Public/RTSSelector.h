@@ -7,9 +7,21 @@
 #include "InputMappingContext.h"
 #include "RTSHUD.h"
 #include "RTSSelectable.h"
+#include "RTSSelectionFilter.h"
+#include "RTSSelectionFrustum.h"
+#include "RTSSelectionListener.h"
+#include "RTSSelectionSet.h"
+#include "Camera/CameraTypes.h"
 #include "Components/ActorComponent.h"
+#include "UObject/WeakInterfacePtr.h"
 #include "RTSSelector.generated.h"
 
+class URTSActorGroup;
+class URTSSelectionIndicatorComponent;
+class UMaterialInterface;
+class UStaticMesh;
+class URTSSelectionSubsystem;
+
 UCLASS(Blueprintable, BlueprintType, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class OPENRTSCAMERA_API URTSSelector : public UActorComponent
 {
@@ -18,6 +30,12 @@ class OPENRTSCAMERA_API URTSSelector : public UActorComponent
 public:
 	URTSSelector();
 
+	virtual void TickComponent(
+		float DeltaTime,
+		ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction
+	) override;
+
 	// BlueprintAssignable allows binding in Blueprints
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActorsSelected, const TArray<AActor*>&, SelectedActors);
 	UPROPERTY(BlueprintAssignable)
@@ -38,10 +56,42 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "RTSCamera - Selection")
 	void HandleSelectedActors(const TArray<AActor*>& NewSelectedActors);
 	
-	// Function to filter selectable actors, can be overriden in Blueprints
+	/**
+	 * Selects the units whose bounds touch the frustum under the screen rectangle from Start to End, deprojected
+	 * through the player's current view. Runs immediately and does not need an `ARTSHUD` or a canvas.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection")
+	void SelectInScreenRectangle(FVector2D Start, FVector2D End);
+
+	// Selects the units whose bounds touch Frustum, e.g. for a view that is not on screen in headless automation
+	void SelectInFrustum(const FRTSSelectionFrustum& Frustum);
+
+	// Returns the selectable under ScreenPosition (in viewport pixels), within PointPickTolerance of its bounds
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection")
+	URTSSelectable* PickSelectableAt(FVector2D ScreenPosition) const;
+
+	// Releasing the selection within this many DPI scaled pixels of where it started is a click, which selects the
+	// single selectable under the cursor instead of the units in a box
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection", meta = (ClampMin = "0"))
+	float ClickDistanceThreshold;
+
+	// A click still picks a selectable whose bounds are within this many DPI scaled pixels of the cursor
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection", meta = (ClampMin = "0"))
+	float PointPickTolerance;
+
+	// Selects every selectable on screen whose owner is of the same class as Actor, e.g. on double click
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection")
+	void SelectAllOfTypeOnScreen(const AActor* Actor);
+
+	// Function to filter selectable actors, can be overriden in Blueprints. Only called for the actors that already
+	// passed SelectionFilter, and only when a Blueprint overrides it (or CallCanSelectActor is set)
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "RTSCamera - Selection")
 	bool CanSelectActor(AActor* Actor) const;
 
+	// Native filter over the team, categories and selectable flag of each URTSSelectable, applied before CanSelectActor
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	FRTSSelectionFilter SelectionFilter;
+
 	// BlueprintCallable to allow calling from Blueprints
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection")
 	void OnSelectionStart(const FInputActionValue& Value);
@@ -52,21 +102,115 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection")
 	void OnSelectionEnd(const FInputActionValue& Value);
 
-	UPROPERTY(BlueprintReadOnly, Category = "RTSCamera - Selection")
-	TArray<URTSSelectable*> SelectedActors;
+	// The currently selected selectables, resolved from the handles in GetSelection
+	UFUNCTION(BlueprintPure, Category = "RTSCamera - Selection")
+	TArray<URTSSelectable*> GetSelectedActors() const;
+
+	// Handles of the currently selected selectables, in the registry of this selector's world
+	const FRTSSelectionSet& GetSelection() const;
+
+	/**
+	 * The owners of the selected actors as a group that follows every selection change, e.g. for
+	 * `URTSCamera::FollowGroup`. Only kept up to date once it has been requested.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection")
+	URTSActorGroup* GetSelectionGroup();
+
+	// Resolve the selection while dragging and call OnPreviewEnter/OnPreviewExit on the selectables under the box
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	bool EnableSelectionPreview;
+
+	// Call OnSelected/OnDeselected on each selectable, turn off when a selection listener handles them in bulk
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection")
+	bool EnableSelectableEvents;
+
+	// Maximum number of selection notifications delivered per frame, the rest follow in order over the next
+	// frames. Zero delivers everything in the frame the selection changed
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection", meta = (ClampMin = "0"))
+	int32 MaxSelectionNotificationsPerFrame;
+
+	void AddSelectionListener(IRTSSelectionListener* Listener);
+	void RemoveSelectionListener(IRTSSelectionListener* Listener);
+
+	// Draw a ring under every selected unit, all of them through a single instanced static mesh
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection Indicators")
+	bool EnableSelectionIndicators;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection Indicators")
+	UStaticMesh* SelectionIndicatorMesh;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Selection Indicators")
+	UMaterialInterface* SelectionIndicatorMaterial;
+
+	// Null unless EnableSelectionIndicators was set when play began
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Selection Indicators")
+	URTSSelectionIndicatorComponent* GetSelectionIndicators() const;
+
+	static constexpr int32 NumControlGroups = 10;
+
+	// Replaces control group Index (0 to 9) with the current selection
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Control Groups")
+	void AssignControlGroup(int32 Index);
+
+	// Adds the current selection to control group Index
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Control Groups")
+	void AddToControlGroup(int32 Index);
+
+	/**
+	 * Selects control group Index, only notifying the selectables whose selection state changes. Recalling the same
+	 * group twice within ControlGroupDoubleTapTime also jumps the camera to it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Control Groups")
+	void RecallControlGroup(int32 Index);
+
+	// Moves the view target's URTSCamera to the centroid of control group Index
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Control Groups")
+	void JumpToControlGroup(int32 Index);
+
+	// The members of control group Index with their incrementally maintained centroid and bounds
+	UFUNCTION(BlueprintCallable, Category = "RTSCamera - Control Groups")
+	URTSActorGroup* GetControlGroup(int32 Index);
+
+	const FRTSSelectionSet& GetControlGroupSelection(int32 Index) const;
+
+	// Seconds between two recalls of the same control group for the second one to jump the camera
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RTSCamera - Control Groups")
+	float ControlGroupDoubleTapTime;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent);
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Set by native subclasses that override CanSelectActor_Implementation, Blueprint overrides are detected
+	bool CallCanSelectActor;
+
+	// Whether selections (boxes, clicks, select-all-of-type and control group recalls) go through HandleSelectedActors
+	// rather than straight to the registry slots, for subclasses that override it. Blueprint overrides are detected
+	bool CallHandleSelectedActors;
 
 private:
 	UPROPERTY()
 	APlayerController* PlayerController;
 
+	// Optional, only used to draw the selection box
 	UPROPERTY()
 	ARTSHUD* HUD;
 
+	UPROPERTY()
+	URTSActorGroup* SelectionGroup;
+
+	UPROPERTY()
+	URTSSelectionIndicatorComponent* SelectionIndicators;
+
+	// Created the first time each control group is used
+	UPROPERTY()
+	TArray<URTSActorGroup*> ControlGroups;
+	FRTSSelectionSet ControlGroupSelections[NumControlGroups];
+	int32 LastRecalledControlGroup;
+	double LastControlGroupRecallTime;
+
 	FVector2D SelectionStart;
 	FVector2D SelectionEnd;
 
@@ -75,4 +219,78 @@ private:
 	void BindInputActions();
 	void BindInputMappingContext();
 	void CollectComponentDependencyReferences();
+	void CreateSelectionIndicators();
+
+	// Casts the ray under ScreenPosition against the registry grid
+	int32 PickSlotAt(const URTSSelectionSubsystem* Registry, const FVector2D& ScreenPosition) const;
+
+	// Hands NewSelectedSlots to a Blueprint override of HandleSelectedActors if there is one, otherwise selects them.
+	// Every selection entry point goes through here.
+	void HandleNewSelectedSlots(const URTSSelectionSubsystem* Registry);
+
+	// Filters NewSelectedSlots and makes them the selection
+	void SelectNewSelectedSlots(const URTSSelectionSubsystem* Registry);
+
+	// Diffs NewSelectedSlots against the current selection and only notifies the selectables that changed
+	void ApplySelectionDelta(const URTSSelectionSubsystem* Registry);
+
+	// Delivers queued notifications up to the per-frame budget, ticking until the queue is drained. Safe to re-enter
+	// from a callback: nested changes are queued and delivered after the current ones.
+	void DeliverSelectionNotifications();
+	void NotifySelectionChanged(TConstArrayView<URTSSelectable*> Selectables, bool IsSelected);
+
+	void GrowSlotBits(int32 SlotCapacity);
+
+	// Cursor position in viewport pixels from this frame's shared viewport snapshot
+	FVector2D GetCursorPosition() const;
+
+	// Builds the frustum under a screen rectangle from the player's current view
+	bool MakeSelectionFrustum(const FBox2D& Rectangle, FRTSSelectionFrustum& OutFrustum) const;
+
+	// Re-tests what is previewed and only queries the strips that entered the box since the last update, unless the
+	// view moved. Selectables that walk into a box held still are picked up once the box or the view moves again.
+	void UpdateSelectionPreview(const FBox2D& Rectangle);
+	void ClearSelectionPreview();
+
+	// Sends OnPreviewExit to previewed selectables that are no longer under the box and drops unregistered ones
+	void RevalidateSelectionPreview(const URTSSelectionSubsystem* Registry, const FRTSSelectionFrustum& Frustum);
+
+	// Re-tests everything under the box, for when the view moved and the old box covers a different part of the world
+	void ResolveSelectionPreview(const URTSSelectionSubsystem* Registry, const FRTSSelectionFrustum& Frustum);
+
+	// Drops the handles whose slot bit the exit passes cleared
+	void RemoveExitedPreviewHandles();
+
+	// The view the selection frustums are deprojected through, false without a camera manager
+	bool GetSelectionView(FMinimalViewInfo& OutView) const;
+
+	// Not reflected on purpose: handles keep the selection out of the garbage collector's reference scan
+	FRTSSelectionSet Selection;
+
+	// Scratch state reused between selections so that steady-state selection does not allocate
+	TArray<int32> NewSelectedSlots;
+	TBitArray<> NewSelectedSlotBits;
+
+	// Selectables currently under the dragged box, and the box and view they were resolved against. Handles rather
+	// than slots, so that a slot freed and reused by another selectable while dragging is not mistaken for the old one.
+	TArray<FRTSSelectableHandle> PreviewHandles;
+	TBitArray<> PreviewSlotBits;
+	TArray<int32> PreviewStripSlots;
+	FBox2D PreviewRectangle;
+	FMinimalViewInfo PreviewView;
+	FVector2D PreviewViewportSize;
+
+	// Notifications not delivered yet, in order, with whether each one is a selection or a deselection
+	UPROPERTY()
+	TArray<URTSSelectable*> PendingNotifications;
+	TBitArray<> PendingNotificationIsSelected;
+	int32 NextPendingNotification;
+
+	// The batch currently being dispatched, moved off the queue so that callbacks may queue more notifications
+	UPROPERTY()
+	TArray<URTSSelectable*> DeliveringNotifications;
+	TBitArray<> DeliveringNotificationIsSelected;
+	bool IsDeliveringNotifications;
+
+	TArray<TWeakInterfacePtr<IRTSSelectionListener>> SelectionListeners;
 };
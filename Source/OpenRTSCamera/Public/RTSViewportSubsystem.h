@@ -0,0 +1,52 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RTSViewportSubsystem.generated.h"
+
+class FViewport;
+
+/** Cursor and viewport state of the game viewport for one frame, in viewport pixels. */
+struct OPENRTSCAMERA_API FRTSViewportSnapshot
+{
+	FVector2D CursorPosition = FVector2D::ZeroVector;
+	bool IsCursorInViewport = false;
+	FVector2D ViewportSize = FVector2D::ZeroVector;
+	float DPIScale = 1.0f;
+};
+
+/**
+ * Captures the cursor position once per frame so that `URTSCamera` (edge scrolling, dragging) and `URTSSelector`
+ * share one query instead of each asking Slate. The viewport size and DPI scale only change when the viewport is
+ * resized, so they are cached until then.
+ */
+UCLASS()
+class OPENRTSCAMERA_API URTSViewportSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Returns the snapshot of the current frame, capturing it on first use. */
+	const FRTSViewportSnapshot& GetViewportSnapshot();
+
+	/**
+	 * Returns Override as the snapshot of every frame instead of asking the game viewport, e.g. for automation tests
+	 * and benchmarks that run without one and place the cursor themselves.
+	 */
+	void SetViewportSnapshotOverride(const FRTSViewportSnapshot& Override);
+	void ClearViewportSnapshotOverride();
+
+private:
+	void OnViewportResized(FViewport* Viewport, uint32 Unused);
+
+	FRTSViewportSnapshot Snapshot;
+	uint64 SnapshotFrameCounter = TNumericLimits<uint64>::Max();
+	bool IsViewportGeometryValid = false;
+	bool IsSnapshotOverridden = false;
+	FDelegateHandle ViewportResizedHandle;
+};
@@ -0,0 +1,22 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class OpenRTSCameraTests : ModuleRules
+{
+	public OpenRTSCameraTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"EnhancedInput",
+				"OpenRTSCamera"
+			}
+		);
+	}
+}
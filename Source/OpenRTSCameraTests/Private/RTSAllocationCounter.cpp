@@ -0,0 +1,96 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSAllocationCounter.h"
+
+#include "HAL/MemoryBase.h"
+
+namespace
+{
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner = nullptr;
+		int32 NumAllocations = 0;
+
+		virtual void* Malloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			this->CountAllocation();
+			return this->Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				this->CountAllocation();
+			}
+			return this->Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			this->Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(const SIZE_T Count, const uint32 Alignment) override
+		{
+			return this->Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return this->Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual void Trim(const bool bTrimThreadCaches) override
+		{
+			this->Inner->Trim(bTrimThreadCaches);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return this->Inner->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("OpenRTSCameraCountingMalloc");
+		}
+
+	private:
+		void CountAllocation()
+		{
+			if (IsInGameThread())
+			{
+				++this->NumAllocations;
+			}
+		}
+	};
+
+	// Never freed: another thread may still be inside the proxy right after it was uninstalled
+	FCountingMalloc& GetCountingMalloc()
+	{
+		static FCountingMalloc* CountingMalloc = new FCountingMalloc();
+		return *CountingMalloc;
+	}
+}
+
+FRTSScopedAllocationCounter::FRTSScopedAllocationCounter()
+{
+	auto& CountingMalloc = GetCountingMalloc();
+	check(GMalloc != &CountingMalloc);
+
+	CountingMalloc.Inner = GMalloc;
+	CountingMalloc.NumAllocations = 0;
+	GMalloc = &CountingMalloc;
+}
+
+FRTSScopedAllocationCounter::~FRTSScopedAllocationCounter()
+{
+	GMalloc = GetCountingMalloc().Inner;
+}
+
+int32 FRTSScopedAllocationCounter::GetNumAllocations() const
+{
+	return GetCountingMalloc().NumAllocations;
+}
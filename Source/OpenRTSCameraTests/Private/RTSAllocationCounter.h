@@ -0,0 +1,23 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Counts the heap allocations made on the game thread while in scope, by routing `GMalloc` through a counting proxy.
+ * Allocations on other threads are forwarded without being counted. Scopes must not be nested, and platforms that
+ * call their allocator without going through `GMalloc` (`PLATFORM_USES_FIXED_GMalloc_CLASS`) are not counted.
+ */
+class FRTSScopedAllocationCounter
+{
+public:
+	FRTSScopedAllocationCounter();
+	~FRTSScopedAllocationCounter();
+
+	FRTSScopedAllocationCounter(const FRTSScopedAllocationCounter&) = delete;
+	FRTSScopedAllocationCounter& operator=(const FRTSScopedAllocationCounter&) = delete;
+
+	// Mallocs and growing or new reallocs so far
+	int32 GetNumAllocations() const;
+};
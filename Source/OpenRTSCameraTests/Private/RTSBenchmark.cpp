@@ -0,0 +1,423 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSBenchmark.h"
+
+#include "RTSCameraSubsystem.h"
+#include "RTSHUD.h"
+#include "RTSSelectionFrustum.h"
+#include "RTSSelectionSubsystem.h"
+#include "RTSSelector.h"
+#include "RTSTestCamera.h"
+#include "RTSTestWorld.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOpenRTSCameraBenchmark, Log, All);
+
+namespace OpenRTSCameraBenchmark
+{
+	constexpr int32 NumQueryIterations = 50;
+	constexpr int32 NumCameraIterations = 200;
+
+	template <typename FunctionType>
+	FResult Measure(const TCHAR* Name, const int32 NumSelectables, const int32 NumIterations, FunctionType&& Function)
+	{
+		// Warm up caches and scratch buffers first
+		Function();
+
+		FResult Result;
+		Result.Name = Name;
+		Result.NumSelectables = NumSelectables;
+		Result.NumActors = NumSelectables;
+		Result.NumIterations = NumIterations;
+		Result.MinimumMicroseconds = TNumericLimits<double>::Max();
+
+		auto TotalSeconds = 0.0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			const auto StartSeconds = FPlatformTime::Seconds();
+			Result.NumResults = Function();
+			const auto ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+			TotalSeconds += ElapsedSeconds;
+			Result.MinimumMicroseconds = FMath::Min(Result.MinimumMicroseconds, ElapsedSeconds * 1000000.0);
+		}
+
+		Result.MeanMicroseconds = TotalSeconds * 1000000.0 / NumIterations;
+		UE_LOG(
+			LogOpenRTSCameraBenchmark,
+			Display,
+			TEXT("%-32s %6d selectables: mean %10.2f us, min %10.2f us, %d results"),
+			*Result.Name,
+			Result.NumSelectables,
+			Result.MeanMicroseconds,
+			Result.MinimumMicroseconds,
+			Result.NumResults
+		);
+		return Result;
+	}
+
+	// A straight down, orthographic frustum over Area
+	FRTSSelectionFrustum MakeTopDownFrustum(const FBox2D& Area)
+	{
+		const FVector Origins[4] = {
+			FVector(Area.Min.X, Area.Min.Y, 100000.0),
+			FVector(Area.Max.X, Area.Min.Y, 100000.0),
+			FVector(Area.Max.X, Area.Max.Y, 100000.0),
+			FVector(Area.Min.X, Area.Max.Y, 100000.0),
+		};
+		const FVector Directions[4] = {-FVector::UpVector, -FVector::UpVector, -FVector::UpVector, -FVector::UpVector};
+		return FRTSSelectionFrustum(Origins, Directions);
+	}
+
+	TConstArrayView<int32> GetDefaultCounts()
+	{
+		static const int32 Counts[] = {100, 1000, 10000, 50000};
+		return Counts;
+	}
+
+	TConstArrayView<int32> GetBaselineCounts()
+	{
+		static const int32 Counts[] = {1000, 10000, 100000};
+		return Counts;
+	}
+
+	void BenchmarkSelection(const int32 NumSelectables, TArray<FResult>& OutResults)
+	{
+		{
+			FRTSTestWorld TestWorld;
+			TArray<AActor*> Actors;
+			TestWorld.SpawnUnits(NumSelectables, 0, Actors);
+
+			const auto Registry = TestWorld.GetSelectionSubsystem();
+			const auto Selector = TestWorld.GetSelector();
+			const auto Side = FMath::Sqrt(static_cast<double>(NumSelectables)) * FRTSTestWorld::Spacing;
+
+			// A box over a tenth of the selectables, and the same box shifted by half its size for selection changes
+			const auto BoxSize = Side * FMath::Sqrt(0.1);
+			const auto BoxMin = FVector2D(BoxSize * -0.5);
+			const auto Frustum = MakeTopDownFrustum(FBox2D(BoxMin, BoxMin + BoxSize));
+			const auto ShiftedFrustum = MakeTopDownFrustum(FBox2D(BoxMin + BoxSize * 0.5, BoxMin + BoxSize * 1.5));
+
+			TArray<int32> Slots;
+			TArray<int32> Indices;
+			OutResults.Add(Measure(TEXT("GridFrustumQuery"), NumSelectables, NumQueryIterations, [&]
+			{
+				Slots.Reset();
+				Registry->QuerySelectablesInFrustum(Frustum, Slots);
+				return Slots.Num();
+			}));
+
+			const auto NumDense = Registry->GetNumSelectables();
+			OutResults.Add(Measure(TEXT("SweepCullSpheres"), NumSelectables, NumQueryIterations, [&]
+			{
+				Indices.Reset();
+				Frustum.CullSpheres(
+					Registry->GetLocationsX().GetData(),
+					Registry->GetLocationsY().GetData(),
+					Registry->GetLocationsZ().GetData(),
+					Registry->GetBoundsRadii().GetData(),
+					NumDense,
+					Indices
+				);
+				return Indices.Num();
+			}));
+
+			OutResults.Add(Measure(TEXT("SweepCullSpheresScalar"), NumSelectables, NumQueryIterations, [&]
+			{
+				Indices.Reset();
+				Frustum.CullSpheresScalar(
+					Registry->GetLocationsX().GetData(),
+					Registry->GetLocationsY().GetData(),
+					Registry->GetLocationsZ().GetData(),
+					Registry->GetBoundsRadii().GetData(),
+					NumDense,
+					Indices
+				);
+				return Indices.Num();
+			}));
+
+			// Owners as a Blueprint would hand them to the selector
+			TArray<AActor*> Selection;
+			TArray<AActor*> ShiftedSelection;
+			Slots.Reset();
+			Registry->QuerySelectablesInFrustum(Frustum, Slots);
+			for (const auto Slot : Slots)
+			{
+				Selection.Add(Registry->GetOwner(Slot));
+			}
+
+			Slots.Reset();
+			Registry->QuerySelectablesInFrustum(ShiftedFrustum, Slots);
+			for (const auto Slot : Slots)
+			{
+				ShiftedSelection.Add(Registry->GetOwner(Slot));
+			}
+
+			OutResults.Add(Measure(TEXT("HandleSelectedActorsUnchanged"), NumSelectables, NumQueryIterations, [&]
+			{
+				Selector->HandleSelectedActors(Selection);
+				return Selector->GetSelection().Num();
+			}));
+
+			auto IsShifted = false;
+			OutResults.Add(Measure(TEXT("HandleSelectedActorsChanged"), NumSelectables, NumQueryIterations, [&]
+			{
+				IsShifted = !IsShifted;
+				Selector->HandleSelectedActors(IsShifted ? ShiftedSelection : Selection);
+				return Selector->GetSelection().Num();
+			}));
+
+			Selector->ClearSelectedActors();
+
+			// A box over the middle of the screen, from the HUD through the selector as a Blueprint HUD would select
+			const auto HUD = TestWorld.GetHUD();
+			const auto ViewportSize = TestWorld.GetViewportSize();
+			OutResults.Add(Measure(TEXT("PerformSelection"), NumSelectables, NumQueryIterations, [&]
+			{
+				HUD->BeginSelection(ViewportSize * 0.25);
+				HUD->UpdateSelection(ViewportSize * 0.75);
+				HUD->PerformSelection();
+				HUD->EndSelection();
+				return Selector->GetSelection().Num();
+			}));
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	void BenchmarkSelectionBaseline(const int32 NumActors, TArray<FResult>& OutResults)
+	{
+		{
+			FRTSTestWorld TestWorld;
+			const auto NumSelectables = FMath::Max(NumActors / 10, 1);
+			TArray<AActor*> Actors;
+			TestWorld.SpawnUnits(NumSelectables, NumActors - NumSelectables, Actors);
+			UE_LOG(
+				LogOpenRTSCameraBenchmark,
+				Display,
+				TEXT("Selection baseline over %d actors, %d of them selectable"),
+				NumActors,
+				NumSelectables
+			);
+
+			const auto AddResult = [&OutResults, NumActors](FResult&& Result)
+			{
+				Result.NumActors = NumActors;
+				OutResults.Add(MoveTemp(Result));
+			};
+
+			const auto Registry = TestWorld.GetSelectionSubsystem();
+			const auto Selector = TestWorld.GetSelector();
+			const auto HUD = TestWorld.GetHUD();
+			const auto Start = TestWorld.GetViewportSize() * 0.25;
+			const auto End = TestWorld.GetViewportSize() * 0.75;
+
+			// The queries alone
+			TArray<AActor*> SweptActors;
+			AddResult(Measure(TEXT("BaselineActorSweep"), NumSelectables, NumQueryIterations, [&]
+			{
+				TestWorld.GetActorsInSelectionRectangleBySweep(Start, End, SweptActors);
+				return SweptActors.Num();
+			}));
+
+			TArray<int32> Slots;
+			AddResult(Measure(TEXT("GridScreenRectangleQuery"), NumSelectables, NumQueryIterations, [&]
+			{
+				Slots.Reset();
+				FRTSSelectionFrustum Frustum;
+				if (TestWorld.MakeSelectionFrustum(Start, End, Frustum))
+				{
+					Registry->QuerySelectablesInFrustum(Frustum, Slots);
+				}
+				return Slots.Num();
+			}));
+
+			// Whole box selections, where the sweep handed its actors to the selector
+			AddResult(Measure(TEXT("BaselinePerformSelection"), NumSelectables, NumQueryIterations, [&]
+			{
+				TestWorld.GetActorsInSelectionRectangleBySweep(Start, End, SweptActors);
+				Selector->HandleSelectedActors(SweptActors);
+				return Selector->GetSelection().Num();
+			}));
+
+			Selector->ClearSelectedActors();
+			AddResult(Measure(TEXT("PerformSelection"), NumSelectables, NumQueryIterations, [&]
+			{
+				HUD->BeginSelection(Start);
+				HUD->UpdateSelection(End);
+				HUD->PerformSelection();
+				HUD->EndSelection();
+				return Selector->GetSelection().Num();
+			}));
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	void BenchmarkCamera(const int32 NumSelectables, TArray<FResult>& OutResults)
+	{
+		{
+			FRTSTestWorld TestWorld;
+			TArray<AActor*> Actors;
+			TestWorld.SpawnUnits(NumSelectables, 0, Actors);
+
+			const auto Camera = TestWorld.GetCamera();
+			const auto CameraSubsystem = TestWorld.GetCameraSubsystem();
+			const auto ViewportSize = TestWorld.GetViewportSize();
+			constexpr auto DeltaSeconds = FRTSTestWorld::DeltaSeconds;
+
+			OutResults.Add(Measure(TEXT("CameraUpdate"), NumSelectables, NumCameraIterations, [&]
+			{
+				CameraSubsystem->Tick(DeltaSeconds);
+				return 1;
+			}));
+
+			// Without the ground trace, which CameraUpdateDynamicHeight measures on its own. Every benchmark moves back
+			// and forth so that the camera stays over the selectables
+			Camera->EnableDynamicCameraHeight = false;
+			auto Sign = 1.0f;
+			OutResults.Add(Measure(TEXT("CameraUpdateHeldInput"), NumSelectables, NumCameraIterations, [&]
+			{
+				Sign = -Sign;
+				Camera->HoldMoveKeys(Sign, Sign);
+				Camera->HoldRotateKeys(Sign);
+				CameraSubsystem->Tick(DeltaSeconds);
+				return 1;
+			}));
+
+			auto IsAtRightEdge = false;
+			OutResults.Add(Measure(TEXT("CameraUpdateEdgeScroll"), NumSelectables, NumCameraIterations, [&]
+			{
+				IsAtRightEdge = !IsAtRightEdge;
+				const auto CursorX = IsAtRightEdge ? ViewportSize.X - 1.0 : 0.0;
+				TestWorld.SetCursorPosition(FVector2D(CursorX, ViewportSize.Y * 0.5));
+				CameraSubsystem->Tick(DeltaSeconds);
+				return 1;
+			}));
+			TestWorld.SetCursorPosition(ViewportSize * 0.5);
+
+			Camera->EnableDynamicCameraHeight = true;
+			OutResults.Add(Measure(TEXT("CameraUpdateDynamicHeight"), NumSelectables, NumCameraIterations, [&]
+			{
+				Sign = -Sign;
+				Camera->HoldMoveKeys(Sign, 0.0f);
+				CameraSubsystem->Tick(DeltaSeconds);
+				return 1;
+			}));
+
+			Camera->FollowTargets(Actors);
+			OutResults.Add(Measure(TEXT("CameraUpdateFollowGroup"), NumSelectables, NumCameraIterations, [&]
+			{
+				CameraSubsystem->Tick(DeltaSeconds);
+				return Actors.Num();
+			}));
+
+			// Marches the whole group back and forth, so that every member's transform changes each frame
+			auto MarchStep = FVector(FRTSTestWorld::Spacing * DeltaSeconds, 0.0, 0.0);
+			OutResults.Add(Measure(TEXT("CameraUpdateFollowMovingGroup"), NumSelectables, NumCameraIterations, [&]
+			{
+				MarchStep = -MarchStep;
+				for (const auto Actor : Actors)
+				{
+					Actor->AddActorWorldOffset(MarchStep);
+				}
+				CameraSubsystem->Tick(DeltaSeconds);
+				return Actors.Num();
+			}));
+
+			Camera->UnFollowTarget();
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	FString WriteResults(const TArray<FResult>& Results)
+	{
+		const auto Directory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("OpenRTSCamera"));
+		const auto BaseName = FString::Printf(TEXT("Benchmark-%s"), *FDateTime::Now().ToString());
+
+		FString Csv = TEXT("Benchmark,Selectables,Actors,Iterations,MeanMicroseconds,MinimumMicroseconds,Results\n");
+		FString Json = TEXT("[\n");
+		for (int32 Index = 0; Index < Results.Num(); ++Index)
+		{
+			const auto& Result = Results[Index];
+			Csv += FString::Printf(
+				TEXT("%s,%d,%d,%d,%.3f,%.3f,%d\n"),
+				*Result.Name,
+				Result.NumSelectables,
+				Result.NumActors,
+				Result.NumIterations,
+				Result.MeanMicroseconds,
+				Result.MinimumMicroseconds,
+				Result.NumResults
+			);
+			Json += FString::Printf(
+				TEXT("\t{\"benchmark\": \"%s\", \"selectables\": %d, \"actors\": %d, \"iterations\": %d, ")
+				TEXT("\"meanMicroseconds\": %.3f, \"minimumMicroseconds\": %.3f, \"results\": %d}%s\n"),
+				*Result.Name,
+				Result.NumSelectables,
+				Result.NumActors,
+				Result.NumIterations,
+				Result.MeanMicroseconds,
+				Result.MinimumMicroseconds,
+				Result.NumResults,
+				Index + 1 < Results.Num() ? TEXT(",") : TEXT("")
+			);
+		}
+		Json += TEXT("]\n");
+
+		const auto CsvPath = FPaths::Combine(Directory, BaseName + TEXT(".csv"));
+		const auto JsonPath = FPaths::Combine(Directory, BaseName + TEXT(".json"));
+		FFileHelper::SaveStringToFile(Csv, *CsvPath);
+		FFileHelper::SaveStringToFile(Json, *JsonPath);
+		UE_LOG(LogOpenRTSCameraBenchmark, Display, TEXT("Wrote %s and %s"), *CsvPath, *JsonPath);
+		return CsvPath;
+	}
+
+	void Run(const TArray<FString>& Args)
+	{
+		TArray<int32> Counts;
+		for (const auto& Arg : Args)
+		{
+			if (Arg.IsNumeric())
+			{
+				Counts.Add(FMath::Max(FCString::Atoi(*Arg), 1));
+			}
+		}
+
+		// Given counts are used as both selectable and actor counts
+		TArray<int32> BaselineCounts = Counts;
+		if (Counts.Num() == 0)
+		{
+			const auto DefaultCounts = GetDefaultCounts();
+			Counts.Append(DefaultCounts.GetData(), DefaultCounts.Num());
+			const auto DefaultBaselineCounts = GetBaselineCounts();
+			BaselineCounts.Append(DefaultBaselineCounts.GetData(), DefaultBaselineCounts.Num());
+		}
+
+		TArray<FResult> Results;
+		for (const auto Count : Counts)
+		{
+			BenchmarkSelection(Count, Results);
+			BenchmarkCamera(Count, Results);
+		}
+
+		for (const auto Count : BaselineCounts)
+		{
+			BenchmarkSelectionBaseline(Count, Results);
+		}
+
+		WriteResults(Results);
+	}
+}
+
+static FAutoConsoleCommandWithArgs GOpenRTSCameraBenchmarkCommand(
+	TEXT("OpenRTSCamera.Benchmark"),
+	TEXT("Benchmarks selection and camera updates with many selectables and writes the results to Saved/Profiling."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&OpenRTSCameraBenchmark::Run)
+);
@@ -0,0 +1,56 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Benchmarks for selection and camera updates with many selectables. Every benchmark builds its own
+ * `FRTSTestWorld`, so the results do not depend on the level that is open and the camera benchmarks always run.
+ * Results can be written as CSV and JSON to `Saved/Profiling/OpenRTSCamera`, so that runs of different plugin
+ * versions can be compared.
+ *
+ * Run through the `OpenRTSCamera.Benchmark` automation tests, or headless with the console command
+ * `OpenRTSCamera.Benchmark [Count...]`, e.g. `-game -nullrhi -unattended -ExecCmds="OpenRTSCamera.Benchmark,Quit"`.
+ */
+namespace OpenRTSCameraBenchmark
+{
+	struct FResult
+	{
+		FString Name;
+		int32 NumSelectables = 0;
+		int32 NumActors = 0;
+		int32 NumIterations = 0;
+		double MeanMicroseconds = 0.0;
+		double MinimumMicroseconds = 0.0;
+		int32 NumResults = 0;
+	};
+
+	// 100, 1k, 10k and 50k selectables
+	TConstArrayView<int32> GetDefaultCounts();
+
+	// 1k, 10k and 100k actors
+	TConstArrayView<int32> GetBaselineCounts();
+
+	/**
+	 * Selection queries, frustum culling with vector intrinsics and without, `URTSSelector::HandleSelectedActors` and
+	 * box selection through `ARTSHUD::PerformSelection`.
+	 */
+	void BenchmarkSelection(int32 NumSelectables, TArray<FResult>& OutResults);
+
+	/**
+	 * Box selection against how it was resolved before the selection grid, i.e. `AHUD::GetActorsInSelectionRectangle`
+	 * sweeping over every actor in the world. A tenth of the NumActors actors are selectable, the rest are fillers
+	 * that the sweep has to visit just the same.
+	 */
+	void BenchmarkSelectionBaseline(int32 NumActors, TArray<FResult>& OutResults);
+
+	/**
+	 * Camera updates while idle, under held movement and rotation keys, while edge scrolling, with dynamic camera
+	 * height and while following every selectable, both standing still and on the march.
+	 */
+	void BenchmarkCamera(int32 NumSelectables, TArray<FResult>& OutResults);
+
+	// Returns the path of the CSV file, the JSON file is written next to it
+	FString WriteResults(const TArray<FResult>& Results);
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSBenchmark.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	void ReportResults(FAutomationTestBase& Test, const TArray<OpenRTSCameraBenchmark::FResult>& Results)
+	{
+		for (const auto& Result : Results)
+		{
+			Test.AddInfo(FString::Printf(
+				TEXT("%s, %d selectables of %d actors: mean %.2f us, min %.2f us, %d results"),
+				*Result.Name,
+				Result.NumSelectables,
+				Result.NumActors,
+				Result.MeanMicroseconds,
+				Result.MinimumMicroseconds,
+				Result.NumResults
+			));
+
+			// A benchmark that found nothing to do measured nothing
+			Test.TestTrue(
+				FString::Printf(TEXT("%s with %d selectables has results"), *Result.Name, Result.NumSelectables),
+				Result.NumResults > 0
+			);
+		}
+
+		Test.AddInfo(FString::Printf(TEXT("Wrote %s"), *OpenRTSCameraBenchmark::WriteResults(Results)));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSSelectionBenchmarkTest,
+	"OpenRTSCamera.Benchmark.Selection",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FRTSSelectionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TArray<OpenRTSCameraBenchmark::FResult> Results;
+	for (const auto Count : OpenRTSCameraBenchmark::GetDefaultCounts())
+	{
+		OpenRTSCameraBenchmark::BenchmarkSelection(Count, Results);
+	}
+
+	ReportResults(*this, Results);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSSelectionBaselineBenchmarkTest,
+	"OpenRTSCamera.Benchmark.SelectionBaseline",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FRTSSelectionBaselineBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TArray<OpenRTSCameraBenchmark::FResult> Results;
+	for (const auto Count : OpenRTSCameraBenchmark::GetBaselineCounts())
+	{
+		OpenRTSCameraBenchmark::BenchmarkSelectionBaseline(Count, Results);
+	}
+
+	ReportResults(*this, Results);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSCameraBenchmarkTest,
+	"OpenRTSCamera.Benchmark.Camera",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FRTSCameraBenchmarkTest::RunTest(const FString& Parameters)
+{
+	TArray<OpenRTSCameraBenchmark::FResult> Results;
+	for (const auto Count : OpenRTSCameraBenchmark::GetDefaultCounts())
+	{
+		OpenRTSCameraBenchmark::BenchmarkCamera(Count, Results);
+	}
+
+	ReportResults(*this, Results);
+	return true;
+}
+
+#endif
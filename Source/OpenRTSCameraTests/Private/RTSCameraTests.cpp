@@ -0,0 +1,222 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSAllocationCounter.h"
+#include "RTSCameraSubsystem.h"
+#include "RTSTestCamera.h"
+#include "RTSTestWorld.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+	constexpr int32 NumTicksPerSecond = 60;
+
+	FVector Flatten(const FVector& Location)
+	{
+		return FVector(Location.X, Location.Y, 0.0);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSCameraHeldInputTest, "OpenRTSCamera.Camera.HeldInput", TestFlags)
+
+bool FRTSCameraHeldInputTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	const auto Camera = TestWorld.GetCamera();
+	const auto Pawn = TestWorld.GetCameraPawn();
+	Camera->EnableDynamicCameraHeight = false;
+
+	// One second of each key, the camera starts out looking along X
+	const auto Distance = static_cast<double>(Camera->MoveSpeed);
+	const auto Start = Pawn->GetActorLocation();
+	for (int32 Tick = 0; Tick < NumTicksPerSecond; ++Tick)
+	{
+		Camera->HoldMoveKeys(1.0f, 0.0f);
+		TestWorld.TickCamera();
+	}
+	TestEqual(TEXT("Holding forward moves the camera forward"), Pawn->GetActorLocation().X, Start.X + Distance, 0.01);
+	TestEqual(TEXT("Holding forward does not move the camera sideways"), Pawn->GetActorLocation().Y, Start.Y, 0.01);
+
+	for (int32 Tick = 0; Tick < NumTicksPerSecond; ++Tick)
+	{
+		Camera->HoldMoveKeys(0.0f, 1.0f);
+		TestWorld.TickCamera();
+	}
+	TestEqual(TEXT("Holding right moves the camera right"), Pawn->GetActorLocation().Y, Start.Y + Distance, 0.01);
+
+	for (int32 Tick = 0; Tick < 10; ++Tick)
+	{
+		Camera->HoldRotateKeys(1.0f);
+		TestWorld.TickCamera();
+	}
+	TestEqual(TEXT("Holding rotate turns the camera"), Pawn->GetActorRotation().Yaw, 10.0, 0.01);
+
+	// Movement follows the turned camera
+	const auto TurnedStart = Pawn->GetActorLocation();
+	Camera->HoldMoveKeys(1.0f, 0.0f);
+	TestWorld.TickCamera();
+	const auto Step = Pawn->GetActorLocation() - TurnedStart;
+	TestEqual(TEXT("Holding forward after turning moves along the new heading"), Step.Rotation().Yaw, 10.0, 0.01);
+
+	// Releasing every key lets the camera come to rest
+	TestWorld.TickCamera();
+	const auto RestingLocation = Pawn->GetActorLocation();
+	TestWorld.TickCamera();
+	TestEqual(TEXT("The camera stops when no key is held"), Pawn->GetActorLocation(), RestingLocation);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSCameraHeldInputAllocationTest,
+	"OpenRTSCamera.Camera.HeldInputDoesNotAllocate",
+	TestFlags
+)
+
+bool FRTSCameraHeldInputAllocationTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	const auto Camera = TestWorld.GetCamera();
+	const auto Pawn = TestWorld.GetCameraPawn();
+	const auto CameraSubsystem = TestWorld.GetCameraSubsystem();
+
+	// Ground traces allocate inside the physics scene, they are covered by the DynamicHeight test
+	Camera->EnableDynamicCameraHeight = false;
+
+	const auto HoldKeys = [Camera, CameraSubsystem]
+	{
+		Camera->HoldMoveKeys(1.0f, 1.0f);
+		Camera->HoldRotateKeys(1.0f);
+		CameraSubsystem->Tick(FRTSTestWorld::DeltaSeconds);
+	};
+
+	// The first ticks size the subsystem's scratch arrays
+	HoldKeys();
+	HoldKeys();
+
+	const auto Start = Pawn->GetActorTransform();
+	int32 NumAllocations;
+	{
+		const FRTSScopedAllocationCounter AllocationCounter;
+		for (int32 Tick = 0; Tick < NumTicksPerSecond; ++Tick)
+		{
+			HoldKeys();
+		}
+		NumAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	TestEqual(TEXT("Ticking with held keys does not allocate"), NumAllocations, 0);
+	TestFalse(TEXT("The held keys moved the camera"), Pawn->GetActorTransform().Equals(Start));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSCameraEdgeScrollTest, "OpenRTSCamera.Camera.EdgeScroll", TestFlags)
+
+bool FRTSCameraEdgeScrollTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	const auto Camera = TestWorld.GetCamera();
+	const auto Pawn = TestWorld.GetCameraPawn();
+	const auto ViewportSize = TestWorld.GetViewportSize();
+	Camera->EnableDynamicCameraHeight = false;
+
+	const auto Start = Pawn->GetActorLocation();
+	TestWorld.TickCamera();
+	TestEqual(TEXT("A cursor in the middle of the screen does not scroll"), Pawn->GetActorLocation(), Start);
+
+	// One pixel from the right edge is almost all the way into the edge band
+	const auto Cursor = FVector2D(ViewportSize.X - 1.0, ViewportSize.Y * 0.5);
+	const auto EdgeSize = ViewportSize.X * Camera->DistanceFromEdgeThreshold;
+	const auto Distance = Camera->EdgeScrollSpeed * (Cursor.X - ViewportSize.X + EdgeSize) / EdgeSize;
+	TestWorld.SetCursorPosition(Cursor);
+	for (int32 Tick = 0; Tick < NumTicksPerSecond; ++Tick)
+	{
+		TestWorld.TickCamera();
+	}
+	TestEqual(TEXT("The right edge scrolls the camera right"), Pawn->GetActorLocation().Y, Start.Y + Distance, 0.01);
+	TestEqual(TEXT("The right edge does not scroll forward"), Pawn->GetActorLocation().X, Start.X, 0.01);
+
+	TestWorld.SetCursorPosition(ViewportSize * 0.5);
+	TestWorld.TickCamera();
+	const auto RestingLocation = Pawn->GetActorLocation();
+	for (int32 Tick = 0; Tick < 10; ++Tick)
+	{
+		TestWorld.TickCamera();
+	}
+	TestEqual(TEXT("Scrolling stops when the cursor leaves the edge"), Pawn->GetActorLocation(), RestingLocation);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSCameraDynamicHeightTest, "OpenRTSCamera.Camera.DynamicHeight", TestFlags)
+
+bool FRTSCameraDynamicHeightTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	const auto Camera = TestWorld.GetCamera();
+	const auto Pawn = TestWorld.GetCameraPawn();
+
+	// The test world's ground is at Z = 0
+	Camera->JumpTo(FVector(300.0, -300.0, 1000.0));
+	TestWorld.TickCamera();
+	TestEqual(TEXT("The camera is moved down onto the ground"), Pawn->GetActorLocation().Z, 0.0, 0.01);
+
+	Camera->JumpTo(FVector(300.0, -300.0, -1000.0));
+	TestWorld.TickCamera();
+	TestEqual(TEXT("The camera is moved up onto the ground"), Pawn->GetActorLocation().Z, 0.0, 0.01);
+
+	Camera->EnableDynamicCameraHeight = false;
+	Camera->JumpTo(FVector(300.0, -300.0, 1000.0));
+	TestWorld.TickCamera();
+	TestEqual(TEXT("Without dynamic height the camera keeps its height"), Pawn->GetActorLocation().Z, 1000.0, 0.01);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSCameraFollowGroupTest, "OpenRTSCamera.Camera.FollowGroup", TestFlags)
+
+bool FRTSCameraFollowGroupTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	const auto Camera = TestWorld.GetCamera();
+	const auto Pawn = TestWorld.GetCameraPawn();
+
+	// Units are centred on the origin
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(25, 0, Units);
+	Camera->JumpTo(FVector(2000.0, 2000.0, 0.0));
+	Camera->FollowTargets(Units);
+	TestWorld.TickCamera();
+	TestEqual(TEXT("The camera centres on the group"), Flatten(Pawn->GetActorLocation()), FVector::ZeroVector, 0.01);
+
+	const auto Offset = FVector(500.0, -250.0, 0.0);
+	for (const auto Unit : Units)
+	{
+		Unit->AddActorWorldOffset(Offset);
+	}
+	TestWorld.TickCamera();
+	TestEqual(TEXT("The camera follows the group as it moves"), Flatten(Pawn->GetActorLocation()), Offset, 0.01);
+
+	const auto DestroyedUnit = Units.Pop();
+	const auto DestroyedLocation = Flatten(DestroyedUnit->GetActorLocation());
+	DestroyedUnit->Destroy();
+	TestWorld.TickCamera();
+	TestEqual(
+		TEXT("The camera recentres when a member is destroyed"),
+		Flatten(Pawn->GetActorLocation()),
+		Offset - (DestroyedLocation - Offset) / Units.Num(),
+		0.01
+	);
+
+	Camera->UnFollowTarget();
+	const auto UnfollowedLocation = Pawn->GetActorLocation();
+	for (const auto Unit : Units)
+	{
+		Unit->AddActorWorldOffset(Offset);
+	}
+	TestWorld.TickCamera();
+	TestEqual(TEXT("The camera stays put after unfollowing"), Pawn->GetActorLocation(), UnfollowedLocation);
+	return true;
+}
+
+#endif
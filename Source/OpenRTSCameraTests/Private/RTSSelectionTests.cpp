@@ -0,0 +1,357 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "InputActionValue.h"
+#include "RTSHUD.h"
+#include "RTSSelectable.h"
+#include "RTSSelectionFrustum.h"
+#include "RTSSelectionIndicatorComponent.h"
+#include "RTSSelector.h"
+#include "RTSTestCamera.h"
+#include "RTSTestWorld.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	// 11 by 11 units, the one in the middle sits at the origin right under the camera
+	constexpr int32 NumUnits = 121;
+	constexpr int32 CenterUnit = 60;
+
+	TSet<AActor*> GetSelectedOwners(const URTSSelector* Selector)
+	{
+		TSet<AActor*> Owners;
+		for (const auto Selectable : Selector->GetSelectedActors())
+		{
+			Owners.Add(Selectable->GetOwner());
+		}
+		return Owners;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSPerformSelectionTest, "OpenRTSCamera.Selection.PerformSelection", TestFlags)
+
+bool FRTSPerformSelectionTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(NumUnits, 0, Units);
+
+	const auto HUD = TestWorld.GetHUD();
+	const auto Selector = TestWorld.GetSelector();
+	if (!TestNotNull(TEXT("The player has an ARTSHUD"), HUD))
+	{
+		return false;
+	}
+
+	// A small box around the middle of the screen
+	const auto Center = TestWorld.GetViewportSize() * 0.5;
+	HUD->BeginSelection(Center - 60.0);
+	HUD->UpdateSelection(Center + 60.0);
+	HUD->PerformSelection();
+	HUD->EndSelection();
+
+	const auto Selected = GetSelectedOwners(Selector);
+	TestTrue(TEXT("The unit under the box is selected"), Selected.Contains(Units[CenterUnit]));
+	TestFalse(TEXT("A unit far from the box is not selected"), Selected.Contains(Units[0]));
+	TestTrue(TEXT("Not every unit is selected"), Selected.Num() < NumUnits);
+
+	// The HUD hands the box to the selector, which resolves it the same way as SelectInScreenRectangle
+	Selector->ClearSelectedActors();
+	TestEqual(TEXT("Clearing empties the selection"), Selector->GetSelection().Num(), 0);
+	Selector->SelectInScreenRectangle(Center - 60.0, Center + 60.0);
+	const auto SelectedInRectangle = GetSelectedOwners(Selector);
+	TestEqual(TEXT("PerformSelection matches SelectInScreenRectangle"), SelectedInRectangle.Num(), Selected.Num());
+	TestTrue(TEXT("PerformSelection selects the same units"), SelectedInRectangle.Includes(Selected));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSSelectionMatchesSweepTest,
+	"OpenRTSCamera.Selection.MatchesActorSweep",
+	TestFlags
+)
+
+bool FRTSSelectionMatchesSweepTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(400, 1200, Units);
+
+	const auto Camera = TestWorld.GetCamera();
+	const auto Selector = TestWorld.GetSelector();
+	const auto ViewportSize = TestWorld.GetViewportSize();
+
+	// Boxes in the middle and at the edges of the screen, for a camera that looks along X and a turned one
+	const FBox2D Boxes[] = {
+		FBox2D(ViewportSize * 0.25, ViewportSize * 0.75),
+		FBox2D(FVector2D::ZeroVector, ViewportSize * FVector2D(0.3, 0.5)),
+		FBox2D(ViewportSize * FVector2D(0.6, 0.7), ViewportSize),
+	};
+
+	for (const auto YawDelta : {0.0f, 30.0f})
+	{
+		Camera->HoldRotateKeys(YawDelta);
+		TestWorld.TickCamera();
+
+		for (const auto& Box : Boxes)
+		{
+			// The grid tests bounding spheres, which enclose the bounding boxes that the sweep projects
+			TArray<AActor*> SweptActors;
+			TestWorld.GetActorsInSelectionRectangleBySweep(Box.Min, Box.Max, SweptActors);
+			Selector->SelectInScreenRectangle(Box.Min, Box.Max);
+			const auto Selected = GetSelectedOwners(Selector);
+
+			const auto What = FString::Printf(TEXT("Box %s at yaw %.0f"), *Box.ToString(), YawDelta);
+			TestTrue(What + TEXT(" contains selectables"), SweptActors.Num() > 0);
+			TestTrue(
+				What + TEXT(" selects every selectable the actor sweep finds"),
+				Selected.Includes(TSet<AActor*>(SweptActors))
+			);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSCullSpheresMatchesScalarTest,
+	"OpenRTSCamera.Selection.CullSpheresMatchesScalar",
+	TestFlags
+)
+
+bool FRTSCullSpheresMatchesScalarTest::RunTest(const FString& Parameters)
+{
+	// Not a multiple of four, so that the scalar tail of the vector loop is covered too
+	constexpr int32 NumSpheres = 1023;
+
+	FRandomStream Random(1234);
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	TArray<float> Radius;
+	for (int32 Index = 0; Index < NumSpheres; ++Index)
+	{
+		X.Add(Random.FRandRange(-5000.0f, 5000.0f));
+		Y.Add(Random.FRandRange(-5000.0f, 5000.0f));
+		Z.Add(Random.FRandRange(-500.0f, 500.0f));
+		Radius.Add(Random.FRandRange(0.0f, 200.0f));
+	}
+
+	// A perspective frustum looking down at an angle, as the camera sees the ground
+	const FVector Origin(-3000.0, 0.0, 3000.0);
+	const FVector CornerOrigins[4] = {Origin, Origin, Origin, Origin};
+	const FVector CornerDirections[4] = {
+		FVector(1.0, -0.5, -0.8).GetSafeNormal(),
+		FVector(1.0, 0.5, -0.8).GetSafeNormal(),
+		FVector(1.0, 0.3, -1.2).GetSafeNormal(),
+		FVector(1.0, -0.3, -1.2).GetSafeNormal(),
+	};
+	const FRTSSelectionFrustum Frustum(CornerOrigins, CornerDirections);
+
+	TArray<int32> Vectorized;
+	Frustum.CullSpheres(X.GetData(), Y.GetData(), Z.GetData(), Radius.GetData(), NumSpheres, Vectorized);
+	TArray<int32> Scalar;
+	Frustum.CullSpheresScalar(X.GetData(), Y.GetData(), Z.GetData(), Radius.GetData(), NumSpheres, Scalar);
+
+	TestTrue(TEXT("The frustum contains spheres"), Scalar.Num() > 0);
+	TestTrue(TEXT("The frustum leaves out spheres"), Scalar.Num() < NumSpheres);
+	TestEqual(TEXT("CullSpheres keeps as many spheres as CullSpheresScalar"), Vectorized.Num(), Scalar.Num());
+	TestTrue(
+		TEXT("CullSpheres keeps the same spheres as CullSpheresScalar"),
+		TSet<int32>(Vectorized).Includes(TSet<int32>(Scalar))
+	);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSSelectionDragTest, "OpenRTSCamera.Selection.Drag", TestFlags)
+
+bool FRTSSelectionDragTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(NumUnits, 0, Units);
+
+	const auto Selector = TestWorld.GetSelector();
+	const auto Center = TestWorld.GetViewportSize() * 0.5;
+
+	// Dragging the select button over the screen, as the input actions would
+	TestWorld.SetCursorPosition(Center - 60.0);
+	Selector->OnSelectionStart(FInputActionValue(true));
+	TestWorld.SetCursorPosition(Center + 60.0);
+	Selector->OnUpdateSelection(FInputActionValue(true));
+	Selector->OnSelectionEnd(FInputActionValue(false));
+
+	const auto Dragged = GetSelectedOwners(Selector);
+	TestTrue(TEXT("Dragging selects the units in the box"), Dragged.Contains(Units[CenterUnit]));
+	TestFalse(TEXT("Dragging leaves out units outside of the box"), Dragged.Contains(Units[0]));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSSelectionClickTest, "OpenRTSCamera.Selection.Click", TestFlags)
+
+bool FRTSSelectionClickTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(NumUnits, 0, Units);
+
+	const auto Selector = TestWorld.GetSelector();
+	const auto Center = TestWorld.GetViewportSize() * 0.5;
+
+	// Clicking without dragging selects only the unit under the cursor
+	TestWorld.SetCursorPosition(Center);
+	Selector->OnSelectionStart(FInputActionValue(true));
+	Selector->OnSelectionEnd(FInputActionValue(false));
+
+	const auto Clicked = GetSelectedOwners(Selector);
+	TestEqual(TEXT("Clicking selects one unit"), Clicked.Num(), 1);
+	TestTrue(TEXT("Clicking selects the unit under the cursor"), Clicked.Contains(Units[CenterUnit]));
+
+	const auto Picked = Selector->PickSelectableAt(Center);
+	TestTrue(
+		TEXT("PickSelectableAt finds the unit under the cursor"),
+		Picked != nullptr && Picked->GetOwner() == Units[CenterUnit]
+	);
+
+	// The top left corner looks at the ground far beyond the units
+	TestWorld.SetCursorPosition(FVector2D::ZeroVector);
+	Selector->OnSelectionStart(FInputActionValue(true));
+	Selector->OnSelectionEnd(FInputActionValue(false));
+	TestEqual(TEXT("Clicking on empty ground clears the selection"), Selector->GetSelection().Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSSelectionClickWithoutCollisionTest,
+	"OpenRTSCamera.Selection.ClickWithoutCollision",
+	TestFlags
+)
+
+bool FRTSSelectionClickWithoutCollisionTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(NumUnits, 0, Units, ECollisionEnabled::NoCollision);
+
+	// Without a pixel tolerance only the unit's own bounds can catch the click
+	const auto Selector = TestWorld.GetSelector();
+	Selector->PointPickTolerance = 0.0f;
+
+	// Most of a radius to the side of the unit's centre, still on its sphere
+	FVector2D Cursor;
+	const auto OffCentre = FVector(0.0, FRTSTestWorld::UnitRadius * 0.8, FRTSTestWorld::UnitRadius);
+	if (!TestTrue(
+		TEXT("The unit is on screen"),
+		TestWorld.GetPlayerController()->ProjectWorldLocationToScreen(OffCentre, Cursor)
+	))
+	{
+		return false;
+	}
+
+	TestWorld.SetCursorPosition(Cursor);
+	Selector->OnSelectionStart(FInputActionValue(true));
+	Selector->OnSelectionEnd(FInputActionValue(false));
+
+	const auto Clicked = GetSelectedOwners(Selector);
+	TestEqual(TEXT("Clicking a unit without collision selects one unit"), Clicked.Num(), 1);
+	TestTrue(TEXT("Clicking a unit without collision selects it"), Clicked.Contains(Units[CenterUnit]));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSSelectionIndicatorsTest,
+	"OpenRTSCamera.Selection.Indicators",
+	TestFlags
+)
+
+bool FRTSSelectionIndicatorsTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(6, 0, Units);
+
+	const auto IndicatorActor = TestWorld.GetWorld()->SpawnActor<AActor>();
+	const auto Indicators = NewObject<URTSSelectionIndicatorComponent>(IndicatorActor);
+	IndicatorActor->SetRootComponent(Indicators);
+	Indicators->RegisterComponent();
+
+	TArray<URTSSelectable*> Selectables;
+	for (const auto Unit : Units)
+	{
+		Selectables.Add(Unit->FindComponentByClass<URTSSelectable>());
+	}
+	Indicators->OnSelectablesSelected(Selectables);
+	TestEqual(TEXT("Every selected unit gets a ring"), Indicators->GetInstanceCount(), Units.Num());
+
+	// The first, a middle and the last ring, so that holes are filled from the end and the end itself is dropped
+	Indicators->OnSelectablesDeselected({Selectables[0], Selectables[3], Selectables[5]});
+	TestEqual(TEXT("Deselected units lose their ring"), Indicators->GetInstanceCount(), 3);
+
+	// Rings sit at their unit's location, each remaining unit must still have one
+	TArray<FVector> RingLocations;
+	for (int32 Index = 0; Index < Indicators->GetInstanceCount(); ++Index)
+	{
+		FTransform Transform;
+		Indicators->GetInstanceTransform(Index, Transform, true);
+		RingLocations.Add(Transform.GetLocation());
+		TestTrue(TEXT("Rings are scaled to the unit's bounds"), Transform.GetScale3D().X > 0.0);
+	}
+
+	for (const auto Index : {1, 2, 4})
+	{
+		const auto Location = Units[Index]->GetActorLocation();
+		TestTrue(
+			FString::Printf(TEXT("Unit %d keeps its ring"), Index),
+			RingLocations.ContainsByPredicate([&Location](const FVector& RingLocation)
+			{
+				return RingLocation.Equals(Location, 0.01);
+			})
+		);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRTSHandleSelectedActorsTest,
+	"OpenRTSCamera.Selection.HandleSelectedActors",
+	TestFlags
+)
+
+bool FRTSHandleSelectedActorsTest::RunTest(const FString& Parameters)
+{
+	FRTSTestWorld TestWorld;
+	TArray<AActor*> Units;
+	TestWorld.SpawnUnits(4, 0, Units);
+
+	const auto Selector = TestWorld.GetSelector();
+	const auto Filler = TestWorld.GetWorld()->SpawnActor<AActor>();
+
+	// Actors without a URTSSelectable and null entries are skipped, duplicates are selected once
+	Selector->HandleSelectedActors({Units[0], Filler, nullptr, Units[1], Units[0]});
+	auto Selected = GetSelectedOwners(Selector);
+	TestEqual(TEXT("Only selectable actors are selected"), Selected.Num(), 2);
+	TestTrue(TEXT("The first unit is selected"), Selected.Contains(Units[0]));
+	TestTrue(TEXT("The second unit is selected"), Selected.Contains(Units[1]));
+
+	Selector->HandleSelectedActors({Units[2]});
+	Selected = GetSelectedOwners(Selector);
+	TestEqual(TEXT("A new selection replaces the old one"), Selected.Num(), 1);
+	TestTrue(TEXT("The new unit is selected"), Selected.Contains(Units[2]));
+
+	Units[2]->Destroy();
+	TestEqual(TEXT("Destroyed units drop out of the selection"), Selector->GetSelectedActors().Num(), 0);
+
+	Selector->HandleSelectedActors({Units[3]});
+	Selector->ClearSelectedActors();
+	TestEqual(TEXT("Clearing empties the selection"), Selector->GetSelection().Num(), 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,16 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSTestCamera.h"
+
+#include "InputActionValue.h"
+
+void URTSTestCamera::HoldMoveKeys(const float Forward, const float Right)
+{
+	this->OnMoveCameraYAxis(FInputActionValue(Forward));
+	this->OnMoveCameraXAxis(FInputActionValue(Right));
+}
+
+void URTSTestCamera::HoldRotateKeys(const float Value)
+{
+	this->OnRotateCamera(FInputActionValue(Value));
+}
@@ -0,0 +1,24 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RTSCamera.h"
+#include "RTSTestCamera.generated.h"
+
+/**
+ * A `URTSCamera` whose input can be driven from tests. Held keys go through the same handlers that the input actions
+ * are bound to, so tests and benchmarks cover the input path without an input device.
+ */
+UCLASS(NotBlueprintable)
+class URTSTestCamera : public URTSCamera
+{
+	GENERATED_BODY()
+
+public:
+	// One frame worth of the move keys, e.g. 1 for W or D held down
+	void HoldMoveKeys(float Forward, float Right);
+
+	// One frame worth of the rotate axis
+	void HoldRotateKeys(float Value);
+};
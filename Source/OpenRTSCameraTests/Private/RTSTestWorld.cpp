@@ -0,0 +1,363 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#include "RTSTestWorld.h"
+
+#include "EngineUtils.h"
+#include "EnhancedInputComponent.h"
+#include "RTSCameraSubsystem.h"
+#include "RTSHUD.h"
+#include "RTSSelectable.h"
+#include "RTSSelectionFrustum.h"
+#include "RTSSelectionSubsystem.h"
+#include "RTSSelector.h"
+#include "RTSTestCamera.h"
+#include "RTSViewportSubsystem.h"
+#include "SceneView.h"
+#include "UnrealClient.h"
+#include "Camera/CameraComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/BoxComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "GameFramework/WorldSettings.h"
+
+namespace
+{
+	const FIntPoint ViewportSize(1920, 1080);
+
+	// The screen space box around the corners of Bounds, as AHUD::GetActorsInSelectionRectangle projects them
+	FBox2D ProjectBounds(const FBox& Bounds, const FIntRect& ViewRect, const FMatrix& ViewProjectionMatrix)
+	{
+		static const FVector BoundsPointMapping[8] = {
+			FVector(1, 1, 1),
+			FVector(1, 1, -1),
+			FVector(1, -1, 1),
+			FVector(1, -1, -1),
+			FVector(-1, 1, 1),
+			FVector(-1, 1, -1),
+			FVector(-1, -1, 1),
+			FVector(-1, -1, -1),
+		};
+
+		const auto Center = Bounds.GetCenter();
+		const auto Extent = Bounds.GetExtent();
+
+		FBox2D ScreenBox(ForceInit);
+		for (const auto& Mapping : BoundsPointMapping)
+		{
+			FVector2D ScreenPosition;
+			const auto Corner = Center + Mapping * Extent;
+			if (FSceneView::ProjectWorldToScreen(Corner, ViewRect, ViewProjectionMatrix, ScreenPosition))
+			{
+				ScreenBox += ScreenPosition;
+			}
+		}
+		return ScreenBox;
+	}
+}
+
+FRTSTestWorld::FRTSTestWorld()
+{
+	// Physics is only there for ground traces, nothing is rendered
+	UWorld::InitializationValues InitializationValues;
+	InitializationValues
+		.InitializeScenes(false)
+		.AllowAudioPlayback(false)
+		.CreatePhysicsScene(true)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.ShouldSimulatePhysics(false)
+		.EnableTraceCollision(true)
+		.SetTransactional(false);
+
+	this->World = UWorld::CreateWorld(
+		EWorldType::Game,
+		false,
+		TEXT("OpenRTSCameraTestWorld"),
+		nullptr,
+		true,
+		ERHIFeatureLevel::Num,
+		&InitializationValues
+	);
+	GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(this->World);
+
+	this->World->InitializeActorsForPlay(FURL());
+	this->World->BeginPlay();
+	this->World->GetWorldSettings()->NotifyBeginPlay();
+
+	this->SpawnGround();
+	this->CreatePlayer();
+	this->SpawnCameraPawn();
+	this->SetCursorPosition(FVector2D(ViewportSize) * 0.5);
+	this->UpdateView();
+}
+
+FRTSTestWorld::~FRTSTestWorld()
+{
+	this->PlayerController->Player = nullptr;
+	this->LocalPlayer->PlayerController = nullptr;
+	this->LocalPlayer->ViewportClient->Viewport = nullptr;
+	this->LocalPlayer->ViewportClient = nullptr;
+	this->LocalPlayer->RemoveFromRoot();
+
+	GEngine->DestroyWorldContext(this->World);
+	this->World->DestroyWorld(false);
+	this->Viewport.Reset();
+}
+
+UWorld* FRTSTestWorld::GetWorld() const
+{
+	return this->World;
+}
+
+APlayerController* FRTSTestWorld::GetPlayerController() const
+{
+	return this->PlayerController;
+}
+
+ARTSHUD* FRTSTestWorld::GetHUD() const
+{
+	return Cast<ARTSHUD>(this->PlayerController->GetHUD());
+}
+
+URTSSelector* FRTSTestWorld::GetSelector() const
+{
+	return this->Selector;
+}
+
+URTSTestCamera* FRTSTestWorld::GetCamera() const
+{
+	return this->Camera;
+}
+
+AActor* FRTSTestWorld::GetCameraPawn() const
+{
+	return this->CameraPawn;
+}
+
+URTSCameraSubsystem* FRTSTestWorld::GetCameraSubsystem() const
+{
+	return this->World->GetSubsystem<URTSCameraSubsystem>();
+}
+
+URTSSelectionSubsystem* FRTSTestWorld::GetSelectionSubsystem() const
+{
+	return this->World->GetSubsystem<URTSSelectionSubsystem>();
+}
+
+FVector2D FRTSTestWorld::GetViewportSize() const
+{
+	return FVector2D(ViewportSize);
+}
+
+void FRTSTestWorld::SpawnUnits(
+	const int32 NumSelectables,
+	const int32 NumFillers,
+	TArray<AActor*>& OutSelectables,
+	const ECollisionEnabled::Type CollisionEnabled
+)
+{
+	const auto NumUnits = NumSelectables + NumFillers;
+	const auto Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumUnits)));
+	const auto Center = (Columns - 1) * 0.5;
+
+	OutSelectables.Reset(NumSelectables);
+	this->Units.Reserve(this->Units.Num() + NumUnits);
+	for (int32 Index = 0; Index < NumUnits; ++Index)
+	{
+		const auto Location = FVector(
+			(Index % Columns - Center) * Spacing,
+			(Index / Columns - Center) * Spacing,
+			UnitRadius
+		);
+
+		// Query only collision keeps the units out of the camera's ground trace
+		const auto Unit = this->World->SpawnActor<AActor>();
+		const auto Collision = NewObject<USphereComponent>(Unit, TEXT("Collision"));
+		Collision->InitSphereRadius(UnitRadius);
+		Collision->SetCollisionEnabled(CollisionEnabled);
+		Collision->SetCollisionObjectType(ECC_WorldDynamic);
+		Collision->SetCollisionResponseToAllChannels(ECR_Ignore);
+		Collision->SetWorldLocation(Location);
+		Unit->SetRootComponent(Collision);
+		Collision->RegisterComponent();
+		this->Units.Add(Unit);
+
+		// Spreads the selectable units evenly between the fillers
+		if ((Index + 1) * static_cast<int64>(NumSelectables) / NumUnits
+			!= Index * static_cast<int64>(NumSelectables) / NumUnits)
+		{
+			NewObject<URTSSelectable>(Unit)->RegisterComponent();
+			OutSelectables.Add(Unit);
+		}
+	}
+}
+
+void FRTSTestWorld::SetCursorPosition(const FVector2D& Position)
+{
+	FRTSViewportSnapshot Snapshot;
+	Snapshot.CursorPosition = Position;
+	Snapshot.IsCursorInViewport = true;
+	Snapshot.ViewportSize = FVector2D(ViewportSize);
+	this->World->GetSubsystem<URTSViewportSubsystem>()->SetViewportSnapshotOverride(Snapshot);
+}
+
+void FRTSTestWorld::TickCamera(const float DeltaTime)
+{
+	this->GetCameraSubsystem()->Tick(DeltaTime);
+	this->UpdateView();
+}
+
+void FRTSTestWorld::UpdateView() const
+{
+	this->SpringArm->TickComponent(0.0f, LEVELTICK_All, nullptr);
+	this->PlayerController->PlayerCameraManager->UpdateCamera(0.0f);
+}
+
+bool FRTSTestWorld::MakeSelectionFrustum(
+	const FVector2D& Start,
+	const FVector2D& End,
+	FRTSSelectionFrustum& OutFrustum
+) const
+{
+	FVector2D Corners[4];
+	FRTSSelectionFrustum::GetScreenRectangleCorners(FRTSSelectionFrustum::MakeScreenRectangle(Start, End), Corners);
+
+	FVector CornerOrigins[4];
+	FVector CornerDirections[4];
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		if (!this->PlayerController->DeprojectScreenPositionToWorld(
+			Corners[Index].X,
+			Corners[Index].Y,
+			CornerOrigins[Index],
+			CornerDirections[Index]
+		))
+		{
+			return false;
+		}
+	}
+
+	OutFrustum = FRTSSelectionFrustum(CornerOrigins, CornerDirections);
+	return true;
+}
+
+void FRTSTestWorld::GetActorsInSelectionRectangleBySweep(
+	const FVector2D& Start,
+	const FVector2D& End,
+	TArray<AActor*>& OutActors
+) const
+{
+	OutActors.Reset();
+
+	FIntRect ViewRect;
+	FMatrix ViewProjectionMatrix;
+	if (!this->GetViewProjection(ViewRect, ViewProjectionMatrix))
+	{
+		return;
+	}
+
+	FBox2D Rectangle(ForceInit);
+	Rectangle += Start;
+	Rectangle += End;
+
+	for (TActorIterator<AActor> Iterator(this->World); Iterator; ++Iterator)
+	{
+		const auto Actor = *Iterator;
+		const auto ActorBox = ProjectBounds(Actor->GetComponentsBoundingBox(false), ViewRect, ViewProjectionMatrix);
+
+		// The HUD handed every overlapping actor to the selector, which then dropped those that are not selectable
+		if (ActorBox.bIsValid && Rectangle.Intersect(ActorBox) && Actor->FindComponentByClass<URTSSelectable>())
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void FRTSTestWorld::CreatePlayer()
+{
+	this->PlayerController = this->World->SpawnActor<APlayerController>();
+	if (this->PlayerController->PlayerCameraManager == nullptr)
+	{
+		this->PlayerController->SpawnPlayerCameraManager();
+	}
+
+	// Deprojection goes through the local player's viewport, which only has to report its size
+	const auto ViewportClient = NewObject<UGameViewportClient>(GEngine);
+	this->Viewport = MakeUnique<FDummyViewport>(ViewportClient);
+	this->Viewport->SetInitialSize(ViewportSize);
+	ViewportClient->Viewport = this->Viewport.Get();
+
+	this->LocalPlayer = NewObject<ULocalPlayer>(GEngine);
+	this->LocalPlayer->AddToRoot();
+	this->LocalPlayer->ViewportClient = ViewportClient;
+	this->LocalPlayer->Origin = FVector2D::ZeroVector;
+	this->LocalPlayer->Size = FVector2D::UnitVector;
+
+	// Without SetPlayer, which would build player input and Slate state that the world never ticks
+	this->LocalPlayer->PlayerController = this->PlayerController;
+	this->PlayerController->Player = this->LocalPlayer;
+	this->PlayerController->InputComponent = NewObject<UEnhancedInputComponent>(this->PlayerController);
+	this->PlayerController->ClientSetHUD(ARTSHUD::StaticClass());
+
+	// The HUD finds the selector on its owning player controller
+	this->Selector = NewObject<URTSSelector>(this->PlayerController);
+	this->Selector->RegisterComponent();
+}
+
+void FRTSTestWorld::SpawnGround() const
+{
+	const auto Ground = this->World->SpawnActor<AActor>();
+	const auto Collision = NewObject<UBoxComponent>(Ground, TEXT("Collision"));
+	Collision->InitBoxExtent(FVector(1000000.0, 1000000.0, 50.0));
+	Collision->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Collision->SetWorldLocation(FVector(0.0, 0.0, -50.0));
+	Ground->SetRootComponent(Collision);
+	Collision->RegisterComponent();
+}
+
+void FRTSTestWorld::SpawnCameraPawn()
+{
+	this->CameraPawn = this->World->SpawnActor<APawn>();
+
+	const auto Root = NewObject<USceneComponent>(this->CameraPawn, TEXT("Root"));
+	this->CameraPawn->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	this->SpringArm = NewObject<USpringArmComponent>(this->CameraPawn, TEXT("SpringArm"));
+	this->SpringArm->SetupAttachment(Root);
+	this->SpringArm->RegisterComponent();
+
+	const auto CameraComponent = NewObject<UCameraComponent>(this->CameraPawn, TEXT("Camera"));
+	CameraComponent->SetupAttachment(this->SpringArm, USpringArmComponent::SocketName);
+	CameraComponent->SetAutoActivate(true);
+	CameraComponent->RegisterComponent();
+
+	// Registered last, so that it finds the spring arm and camera when it begins play. Lag would make every view
+	// depend on the frames before it
+	this->Camera = NewObject<URTSTestCamera>(this->CameraPawn);
+	this->Camera->EnableCameraLag = false;
+	this->Camera->EnableCameraRotationLag = false;
+	this->Camera->RegisterComponent();
+	this->Camera->SetActiveCamera();
+}
+
+bool FRTSTestWorld::GetViewProjection(FIntRect& OutViewRect, FMatrix& OutViewProjectionMatrix) const
+{
+	FSceneViewProjectionData ProjectionData;
+	if (!this->LocalPlayer->GetProjectionData(this->Viewport.Get(), ProjectionData))
+	{
+		return false;
+	}
+
+	OutViewRect = ProjectionData.GetConstrainedViewRect();
+	OutViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	return true;
+}
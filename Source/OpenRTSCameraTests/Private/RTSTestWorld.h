@@ -0,0 +1,103 @@
+// Copyright 2024 Jesus Bracho All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class APlayerController;
+class ARTSHUD;
+class FDummyViewport;
+class ULocalPlayer;
+class URTSCameraSubsystem;
+class URTSSelectionSubsystem;
+class URTSSelector;
+class URTSTestCamera;
+class USpringArmComponent;
+class UWorld;
+struct FRTSSelectionFrustum;
+
+/**
+ * A game world of its own for automation tests and benchmarks, so that they never depend on the level that happens
+ * to be open. It holds a local player with a 1920x1080 dummy viewport, an `ARTSHUD`, a `URTSSelector` on the player
+ * controller, a flat ground at Z = 0 and a camera pawn with a `URTSTestCamera` as the view target.
+ *
+ * The world itself is never ticked. Tests tick the cameras through `TickCamera` and place the cursor through
+ * `SetCursorPosition`, which also updates the view that selection deprojects through.
+ */
+class FRTSTestWorld
+{
+public:
+	static constexpr double Spacing = 200.0;
+	static constexpr float UnitRadius = 50.0f;
+	static constexpr float DeltaSeconds = 1.0f / 60.0f;
+
+	FRTSTestWorld();
+	~FRTSTestWorld();
+
+	FRTSTestWorld(const FRTSTestWorld&) = delete;
+	FRTSTestWorld& operator=(const FRTSTestWorld&) = delete;
+
+	UWorld* GetWorld() const;
+	APlayerController* GetPlayerController() const;
+	ARTSHUD* GetHUD() const;
+	URTSSelector* GetSelector() const;
+	URTSTestCamera* GetCamera() const;
+	AActor* GetCameraPawn() const;
+	URTSCameraSubsystem* GetCameraSubsystem() const;
+	URTSSelectionSubsystem* GetSelectionSubsystem() const;
+	FVector2D GetViewportSize() const;
+
+	/**
+	 * Spawns units on a square grid centred on the origin, with NumFillers plain actors mixed in between the
+	 * NumSelectables selectable ones. Every unit has the same sphere and therefore the same bounds, only the
+	 * selectable ones carry a `URTSSelectable`. The spheres are query only unless CollisionEnabled says otherwise.
+	 */
+	void SpawnUnits(
+		int32 NumSelectables,
+		int32 NumFillers,
+		TArray<AActor*>& OutSelectables,
+		ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::QueryOnly
+	);
+
+	void SetCursorPosition(const FVector2D& Position);
+
+	// One frame of the camera subsystem, followed by the view update the camera manager would do
+	void TickCamera(float DeltaTime = DeltaSeconds);
+
+	// Moves the spring arm and camera to the camera pawn's current transform and caches the view for deprojection
+	void UpdateView() const;
+
+	// The frustum URTSSelector builds for a box selection between two screen points
+	bool MakeSelectionFrustum(const FVector2D& Start, const FVector2D& End, FRTSSelectionFrustum& OutFrustum) const;
+
+	/**
+	 * The actors with a `URTSSelectable` whose projected bounds overlap the screen rectangle, found the way
+	 * `AHUD::GetActorsInSelectionRectangle` does: by iterating every actor in the world and projecting the corners of
+	 * its bounding box. This is what box selection cost before the selection grid.
+	 */
+	void GetActorsInSelectionRectangleBySweep(
+		const FVector2D& Start,
+		const FVector2D& End,
+		TArray<AActor*>& OutActors
+	) const;
+
+private:
+	void CreatePlayer();
+	void SpawnGround() const;
+	void SpawnCameraPawn();
+
+	// The view rectangle and matrix that the HUD's canvas projects through
+	bool GetViewProjection(FIntRect& OutViewRect, FMatrix& OutViewProjectionMatrix) const;
+
+	UWorld* World = nullptr;
+	ULocalPlayer* LocalPlayer = nullptr;
+	TUniquePtr<FDummyViewport> Viewport;
+	APlayerController* PlayerController = nullptr;
+	URTSSelector* Selector = nullptr;
+	URTSTestCamera* Camera = nullptr;
+	USpringArmComponent* SpringArm = nullptr;
+	AActor* CameraPawn = nullptr;
+	TArray<AActor*> Units;
+};